@@ -29,24 +29,88 @@
 #include "calculator.h"
 #include <QDebug>
 #include <QSettings>
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadStorage>
 #include "../core/vapplication.h"
 #include "vcontainer.h"
 #include "../core/vsettings.h"
 
 using namespace qmu;
 
+/**
+ * @brief The VCompiledFormula struct result of parsing formula that doesn't depend on values of variables.
+ */
+struct VCompiledFormula
+{
+    VCompiledFormula()
+        :tokens(QMap<int, QString>()), value(0), byteCode(QmuParserByteCode()), vars(QVector<QString>()),
+          finalResultIdx(0)
+    {}
+
+    /** @brief tokens variables and functions in formula. Empty if formula contains only numbers. */
+    QMap<int, QString> tokens;
+
+    /** @brief value result of formula without tokens. */
+    qreal value;
+
+    QmuParserByteCode byteCode;
+
+    /** @brief vars names of variables in order of bytecode. See QmuParserByteCode::GetVars(). */
+    QVector<QString> vars;
+
+    int finalResultIdx;
+};
+
+namespace
+{
+// Formulas of tools in dialogs change with each key press, so we keep only last used formulas.
+const int maxCompiledFormulas = 10000;
+
+//---------------------------------------------------------------------------------------------------------------------
+QMutex *CompiledFormulasMutex()
+{
+    static QMutex mutex;
+    return &mutex;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QCache<QString, VCompiledFormula> *CompiledFormulas()
+{
+    static QCache<QString, VCompiledFormula> cache(maxCompiledFormulas);
+    return &cache;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QThreadStorage<Calculator *> *Calculators()
+{
+    static QThreadStorage<Calculator *> calculators;
+    return &calculators;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+Calculator *ThreadCalculator(const VContainer *data)
+{
+    if (Calculators()->hasLocalData() == false)
+    {
+        Calculators()->setLocalData(new Calculator(data));
+    }
+    return Calculators()->localData();
+}
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Calculator class wraper for QMuParser. Make easy initialization math parser.
  *
  * This constructor hide initialization variables, operators, character sets.
- * Use this constuctor for evaluation formula. All formulas must be converted to internal look.
+ * Don't create calculator for evaluation formula, static EvalFormula() reuses one calculator per thread. All formulas
+ * must be converted to internal look.
  * Example:
  *
  * const QString formula = qApp->FormulaFromUser(edit->text());
- * Calculator *cal = new Calculator(data);
- * const qreal result = cal->EvalFormula(formula);
- * delete cal;
+ * const qreal result = Calculator::EvalFormula(data, formula);
  *
  * @param data pointer to a variable container.
  */
@@ -113,6 +177,21 @@ qreal Calculator::EvalFormula(const QString &formula)
     SetVarFactory(AddVariable, this);
     SetSepForEval();//Reset separators options
 
+    VCompiledFormula compiled;
+    if (FindCompiled(formula, compiled))
+    {
+        if (compiled.tokens.isEmpty())
+        {
+            return compiled.value;
+        }
+
+        InitVariables(data, compiled.tokens, formula);
+        if (UseCompiled(formula, compiled))
+        {
+            return Eval();
+        }
+    }
+
     SetExpr(formula);
 
     qreal result = 0;
@@ -125,12 +204,336 @@ qreal Calculator::EvalFormula(const QString &formula)
 
     if (tokens.isEmpty())
     {
+        compiled.value = result;
+        SaveCompiled(formula, compiled);
         return result; // We have found only numbers in expression.
     }
 
     // Add variables to parser because we have deal with expression with variables.
     InitVariables(data, tokens, formula);
-    return Eval();
+    result = Eval();
+
+    compiled.tokens = tokens;
+    if (Compile(compiled))
+    {
+        SaveCompiled(formula, compiled);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvalFormula calculate formula with calculator of current thread.
+ *
+ * Creation of parser defines all functions, operators and character sets. It takes more time than evaluation of
+ * usual formula, so each thread creates calculator only once and reuses it. Before each formula we only forget
+ * variables of previous one.
+ * Example:
+ *
+ * const QString formula = qApp->FormulaFromUser(edit->text());
+ * const qreal result = Calculator::EvalFormula(data, formula);
+ *
+ * @param data pointer to a variable container.
+ * @param formula string of formula in internal look.
+ * @return value of formula.
+ */
+qreal Calculator::EvalFormula(const VContainer *data, const QString &formula)
+{
+    SCASSERT(data != nullptr)
+    Calculator *cal = ThreadCalculator(data);
+    cal->data = data;
+    cal->ClearVar();
+    return cal->EvalFormula(formula);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Prepare parse formula and keep bytecode in cache without evaluation with real values.
+ *
+ * Bytecode doesn't depend on values of variables, so formula can be prepared in any thread even before objects that
+ * create variables exist. Each variable gets own place, that's why bytecode can be bound later to real variables. See
+ * EvalFormula().
+ *
+ * @param data pointer to a variable container. Need only for creation of calculator, variables are not used.
+ * @param formula string of formula in internal look.
+ * @return false if formula has error.
+ */
+bool Calculator::Prepare(const VContainer *data, const QString &formula)
+{
+    SCASSERT(data != nullptr)
+    VCompiledFormula compiled;
+    if (FindCompiled(formula, compiled))
+    {
+        return true;
+    }
+
+    Calculator *cal = ThreadCalculator(data);
+    cal->data = data;
+    cal->ClearVar();
+    cal->SetVarFactory(AddVariable, cal);
+    cal->SetSepForEval();
+    try
+    {
+        cal->SetExpr(formula);
+        const qreal result = cal->Eval();
+
+        QMap<int, QString> tokens = cal->GetTokens();
+        RemoveAll(tokens, QStringLiteral("-"));
+        if (tokens.isEmpty())
+        {
+            compiled.value = result;
+            SaveCompiled(formula, compiled);
+            return true;
+        }
+
+        const QStringList names = tokens.values().toSet().toList();
+        QVector<qreal> values(names.size(), 0);
+        for (int i = 0; i < names.size(); ++i)
+        {
+            if (builInFunctions.contains(names.at(i)) == false)
+            {
+                cal->DefineVar(names.at(i), &values[i]);
+            }
+        }
+        cal->Eval();
+
+        compiled.tokens = tokens;
+        if (cal->Compile(compiled))
+        {
+            SaveCompiled(formula, compiled);
+        }
+    }
+    catch (qmu::QmuParserError &e)
+    {
+        Q_UNUSED(e)
+        cal->ClearVar();
+        return false;
+    }
+
+    // Variables point to local values.
+    cal->ClearVar();
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvalFormulaBulk calculate formula for all combinations of sizes and heights in one pass.
+ *
+ * Each measurement and increment is bound as array of its values for each size and height. See
+ * VVariable::GradedValue(). Parser evaluates bytecode once for each element of arrays without new parsing.
+ * Example:
+ *
+ * QVector<qreal> results;
+ * if (Calculator::EvalFormulaBulk(data, formula, sizes, heights, results) == false)
+ * {
+ *     // Formula depends on geometry of pattern, need calculate pattern for each size separately.
+ * }
+ *
+ * @param data pointer to a variable container.
+ * @param formula string of formula in internal look.
+ * @param sizes sizes in pattern units.
+ * @param heights heights in pattern units.
+ * @param results values of formula. Value for size i and height j has index j*sizes.size() + i.
+ * @return false if formula uses lengths, angles or curves. Their values depend on geometry of each size.
+ */
+bool Calculator::EvalFormulaBulk(const VContainer *data, const QString &formula, const QVector<qreal> &sizes,
+                                 const QVector<qreal> &heights, QVector<qreal> &results)
+{
+    SCASSERT(data != nullptr)
+    const int bulkSize = sizes.size() * heights.size();
+    results.resize(bulkSize);
+    if (bulkSize == 0)
+    {
+        return true;
+    }
+
+    Calculator *cal = ThreadCalculator(data);
+    cal->data = data;
+    cal->ClearVar();
+    cal->SetVarFactory(AddVariable, cal);
+    cal->SetSepForEval();
+
+    QMap<int, QString> tokens;
+    qreal value = 0;
+    VCompiledFormula compiled;
+    if (FindCompiled(formula, compiled))
+    {
+        tokens = compiled.tokens;
+        value = compiled.value;
+    }
+    else
+    {
+        cal->SetExpr(formula);
+        value = cal->Eval();
+        tokens = cal->GetTokens();
+        RemoveAll(tokens, QStringLiteral("-"));
+    }
+
+    if (tokens.isEmpty())
+    {
+        results.fill(value);
+        return true;
+    }
+
+    const bool standard = qApp->patternType() == MeasurementsType::Standard;
+    const QHash<QString, QSharedPointer<VInternalVariable> > *vars = data->DataVariables();
+    const QStringList names = tokens.values().toSet().toList();
+    QVector<qreal> values(names.size() * bulkSize, 0);
+    for (int i = 0; i < names.size(); ++i)
+    {
+        const QString &name = names.at(i);
+        if (builInFunctions.contains(name))
+        {
+            continue;
+        }
+
+        qreal *column = values.data() + i * bulkSize;
+        if (standard && (name == data->SizeName() || name == data->HeightName()))
+        {
+            const bool isSize = name == data->SizeName();
+            for (int h = 0; h < heights.size(); ++h)
+            {
+                for (int s = 0; s < sizes.size(); ++s)
+                {
+                    column[h * sizes.size() + s] = isSize ? sizes.at(s) : heights.at(h);
+                }
+            }
+        }
+        else if (vars->contains(name))
+        {
+            const QSharedPointer<VInternalVariable> var = vars->value(name);
+            if (var->GetType() != VarType::Measurement && var->GetType() != VarType::Increment)
+            {
+                cal->ClearVar();
+                return false;
+            }
+
+            const QSharedPointer<VVariable> m = qSharedPointerDynamicCast<VVariable>(var);
+            SCASSERT(m.isNull() == false);
+            for (int h = 0; h < heights.size(); ++h)
+            {
+                for (int s = 0; s < sizes.size(); ++s)
+                {
+                    column[h * sizes.size() + s] = standard ? m->GradedValue(sizes.at(s), heights.at(h))
+                                                            : m->GetValue();
+                }
+            }
+        }
+        else
+        {
+            cal->ClearVar();
+            throw qmu::QmuParserError (ecUNASSIGNABLE_TOKEN, name, formula, tokens.key(name));
+        }
+        cal->DefineVar(name, column);
+    }
+
+    cal->SetExpr(formula);
+    cal->Eval(results.data(), bulkSize);
+
+    // Variables point to local values.
+    cal->ClearVar();
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FindCompiled look for formula in process wide cache of parsed formulas.
+ * @return false if formula was not parsed yet.
+ */
+bool Calculator::FindCompiled(const QString &formula, VCompiledFormula &compiled)
+{
+    QMutexLocker locker(CompiledFormulasMutex());
+    const VCompiledFormula *cached = CompiledFormulas()->object(formula);
+    if (cached == nullptr)
+    {
+        return false;
+    }
+    compiled = *cached;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void Calculator::SaveCompiled(const QString &formula, const VCompiledFormula &compiled)
+{
+    QMutexLocker locker(CompiledFormulasMutex());
+    CompiledFormulas()->insert(formula, new VCompiledFormula(compiled));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Compile keep bytecode of the last evaluation and names of its variables.
+ *
+ * Optimizer merges tokens with the same pointer, so each pointer must belong to only one variable. Otherwise bytecode
+ * can't be used with other pointers.
+ * @return false if bytecode can't be reused.
+ */
+bool Calculator::Compile(VCompiledFormula &compiled) const
+{
+    const QmuParserByteCode &byteCode = GetByteCode();
+    if (byteCode.HasStrFun())
+    {
+        return false;
+    }
+
+    const varmap_type &defined = GetVar();
+    const QVector<qreal*> pointers = byteCode.GetVars();
+    compiled.vars.clear();
+    compiled.vars.reserve(pointers.size());
+    for (int i = 0; i < pointers.size(); ++i)
+    {
+        QString name;
+        for (varmap_type::const_iterator j = defined.begin(); j != defined.end(); ++j)
+        {
+            if (j->second == pointers.at(i))
+            {
+                if (name.isEmpty() == false)
+                {
+                    return false;
+                }
+                name = j->first;
+            }
+        }
+
+        if (name.isEmpty())
+        {
+            return false;
+        }
+        compiled.vars.append(name);
+    }
+
+    compiled.byteCode = byteCode;
+    compiled.finalResultIdx = GetNumResults();
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief UseCompiled bind cached bytecode to variables of this parser. Variables must be already defined.
+ * @return false if some variable is unknown. Formula must be parsed again in this case.
+ */
+bool Calculator::UseCompiled(const QString &formula, VCompiledFormula &compiled)
+{
+    const varmap_type &defined = GetVar();
+    QVector<qreal*> pointers;
+    pointers.reserve(compiled.vars.size());
+    for (int i = 0; i < compiled.vars.size(); ++i)
+    {
+        const varmap_type::const_iterator var = defined.find(compiled.vars.at(i));
+        if (var == defined.end())
+        {
+            return false;
+        }
+        pointers.append(var->second);
+    }
+
+    if (compiled.byteCode.SetVars(pointers) == false)
+    {
+        return false;
+    }
+
+    SetExpr(formula);
+    SetByteCode(compiled.byteCode, compiled.finalResultIdx);
+    return true;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -145,7 +548,7 @@ qreal Calculator::EvalFormula(const QString &formula)
  */
 void Calculator::InitVariables(const VContainer *data, const QMap<int, QString> &tokens, const QString &formula)
 {
-    if (qApp->patternType() == MeasurementsType::Standard)
+    if (qApp->patternType() == MeasurementsType::Standard && vVarVal == nullptr)
     {
         vVarVal = new qreal[2]; //stabdard measurements table have two additional variables
     }
@@ -32,6 +32,7 @@
 #include "../../libs/qmuparser/qmuparser.h"
 
 class VContainer;
+struct VCompiledFormula;
 
 /**
  * @brief The Calculator class for calculation formula.
@@ -47,9 +48,7 @@ class VContainer;
  *     //Need delete dialog here because parser in dialog don't allow use correct separator for parsing here.
  *     //Don't know why.
  *     delete dialog;
- *     Calculator *cal = new Calculator(data);
- *     result = cal->EvalFormula(formula);
- *     delete cal;//Here can be memory leak, but dialog already check this formula and probability very low.
+ *     result = Calculator::EvalFormula(data, formula);
  * }
  */
 class Calculator:public qmu::QmuParser
@@ -59,11 +58,19 @@ public:
     Calculator(const QString &formula, bool fromUser = true);
     ~Calculator();
     qreal         EvalFormula(const QString &formula);
+    static qreal  EvalFormula(const VContainer *data, const QString &formula);
+    static bool   Prepare(const VContainer *data, const QString &formula);
+    static bool   EvalFormulaBulk(const VContainer *data, const QString &formula, const QVector<qreal> &sizes,
+                                  const QVector<qreal> &heights, QVector<qreal> &results);
 private:
     Q_DISABLE_COPY(Calculator)
     qreal *vVarVal;
     const VContainer *data;
     void          InitVariables(const VContainer *data, const QMap<int, QString> &tokens, const QString &formula);
+    static bool   FindCompiled(const QString &formula, VCompiledFormula &compiled);
+    static void   SaveCompiled(const QString &formula, const VCompiledFormula &compiled);
+    bool          Compile(VCompiledFormula &compiled) const;
+    bool          UseCompiled(const QString &formula, VCompiledFormula &compiled);
     void          InitCharacterSets();
     static qreal* AddVariable(const QString &a_szName, void *a_pUserData);
     void          SetSepForEval();
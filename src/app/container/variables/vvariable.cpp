@@ -78,11 +78,23 @@ VVariable::~VVariable()
 
 //---------------------------------------------------------------------------------------------------------------------
 void VVariable::SetValue(const qreal &size, const qreal &height)
+{
+    VInternalVariable::SetValue(GradedValue(size, height));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GradedValue calculate value for size and height. Unlike SetValue() doesn't change variable.
+ * @param size size in pattern units.
+ * @param height height in pattern units.
+ * @return value for size and height. Current value if gradation is not supported.
+ */
+qreal VVariable::GradedValue(const qreal &size, const qreal &height) const
 {
     if (qApp->patternUnit() == Unit::Inch)
     {
         qWarning("Gradation doesn't support inches");
-        return;
+        return VInternalVariable::GetValue();
     }
     const qreal baseSize = VAbstractMeasurements::UnitConvertor(50.0, Unit::Cm, qApp->patternUnit());
     const qreal baseHeight = VAbstractMeasurements::UnitConvertor(176.0, Unit::Cm, qApp->patternUnit());
@@ -92,7 +104,7 @@ void VVariable::SetValue(const qreal &size, const qreal &height)
     // Formula for calculation gradation
     const qreal k_size    = ( size - baseSize ) / sizeIncrement;
     const qreal k_height  = ( height - baseHeight ) / heightIncrement;
-    VInternalVariable::SetValue(d->base + k_size * d->ksize + k_height * d->kheight);
+    return d->base + k_size * d->ksize + k_height * d->kheight;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -57,6 +57,7 @@ public:
     void    SetDescription(const QString &desc);
 
     void    SetValue(const qreal &size, const qreal &height);
+    qreal   GradedValue(const qreal &size, const qreal &height) const;
 
     virtual bool IsNotUsed() const;
 private:
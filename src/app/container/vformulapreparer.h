@@ -0,0 +1,54 @@
+/************************************************************************
+ **
+ **  @file   vformulapreparer.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef VFORMULAPREPARER_H
+#define VFORMULAPREPARER_H
+
+#include <QRunnable>
+#include <QStringList>
+
+class VContainer;
+
+/**
+ * @brief The VFormulaPreparer class parses formulas of one pattern piece and keeps bytecode in cache of calculator.
+ *
+ * Only parsing is done, container is not read. Wrong formulas are skipped, tool will report them during creation.
+ */
+class VFormulaPreparer : public QRunnable
+{
+public:
+    VFormulaPreparer(const QStringList &formulas, const VContainer *data);
+    virtual ~VFormulaPreparer(){}
+
+    virtual void run();
+
+private:
+    Q_DISABLE_COPY(VFormulaPreparer)
+    const QStringList formulas;
+    const VContainer *data;
+};
+
+#endif // VFORMULAPREPARER_H
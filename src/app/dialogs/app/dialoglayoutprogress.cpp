@@ -71,6 +71,17 @@ void DialogLayoutProgress::Arranged(int count)
     ui->progressBar->setValue(count);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutProgress::Optimizing(int percent)
+{
+    if (ui->progressBar->maximum() != 100)
+    {
+        ui->label->setText(tr("Searching better order of workpieces. Please, wait."));
+        ui->progressBar->setMaximum(100);
+    }
+    ui->progressBar->setValue(percent);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void DialogLayoutProgress::Error(const LayoutErrors &state)
 {
@@ -93,6 +104,10 @@ void DialogLayoutProgress::Error(const LayoutErrors &state)
             text = tr("Several workpieces left not arranged, but none of them match for paper");
             QMessageBox::critical(this, tr("Critical error"), text, QMessageBox::Ok, QMessageBox::Ok);
             break;
+        case LayoutErrors::TerminatedByException:
+            text = tr("Creation of layout was terminated by an unexpected error");
+            QMessageBox::critical(this, tr("Critical error"), text, QMessageBox::Ok, QMessageBox::Ok);
+            break;
         default:
             break;
     }
@@ -52,6 +52,7 @@ signals:
 public slots:
     void Start();
     void Arranged(int count);
+    void Optimizing(int percent);
     void Error(const LayoutErrors &state);
     void Finished();
     void StopWorking();
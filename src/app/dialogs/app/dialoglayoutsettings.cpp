@@ -61,6 +61,7 @@ DialogLayoutSettings::DialogLayoutSettings(QWidget *parent)
             this, &DialogLayoutSettings::PaperSizeChanged);
     connect(ui->toolButtonPortrate, &QToolButton::toggled, this, &DialogLayoutSettings::Swap);
     connect(ui->toolButtonLandscape, &QToolButton::toggled, this, &DialogLayoutSettings::Swap);
+    connect(ui->checkBoxRoll, &QCheckBox::toggled, ui->doubleSpinBoxPaperHeight, &QDoubleSpinBox::setDisabled);
     connect(ui->comboBoxLayoutUnit,  static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
             this, &DialogLayoutSettings::ConvertLayoutSize);
 }
@@ -187,6 +188,54 @@ void DialogLayoutSettings::SetIncrease(int increase)
     ui->comboBoxIncrease->setCurrentIndex(index);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool DialogLayoutSettings::GetParallelVariants() const
+{
+    return ui->checkBoxParallelVariants->isChecked();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetParallelVariants(bool state)
+{
+    ui->checkBoxParallelVariants->setChecked(state);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool DialogLayoutSettings::IsRoll() const
+{
+    return ui->checkBoxRoll->isChecked();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetRoll(bool state)
+{
+    ui->checkBoxRoll->setChecked(state);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+Placement DialogLayoutSettings::GetPlacement() const
+{
+    return ui->checkBoxNoFitPolygon->isChecked() ? Placement::NoFitPolygon : Placement::CombineEdges;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetPlacement(Placement value)
+{
+    ui->checkBoxNoFitPolygon->setChecked(value == Placement::NoFitPolygon);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int DialogLayoutSettings::GetOptimizationTime() const
+{
+    return ui->spinBoxOptimizationTime->value();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetOptimizationTime(int seconds)
+{
+    ui->spinBoxOptimizationTime->setValue(seconds);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void DialogLayoutSettings::TemplateSelected()
 {
@@ -32,6 +32,7 @@
 #include <QDialog>
 
 #include "../../libs/vlayout/vbank.h"
+#include "../../libs/vlayout/vlayoutdef.h"
 #include "../../libs/ifc/ifcdef.h"
 
 namespace Ui
@@ -67,6 +68,18 @@ public:
     int GetIncrease() const;
     void SetIncrease(int increase);
 
+    bool GetParallelVariants() const;
+    void SetParallelVariants(bool state);
+
+    bool IsRoll() const;
+    void SetRoll(bool state);
+
+    Placement GetPlacement() const;
+    void      SetPlacement(Placement value);
+
+    int  GetOptimizationTime() const;
+    void SetOptimizationTime(int seconds);
+
 public slots:
     void ConvertPaperSize();
     void ConvertLayoutSize();
@@ -32,6 +32,8 @@
 #include "../../geometry/varc.h"
 #include "../../geometry/vpointf.h"
 #include "../../geometry/vsplinepath.h"
+#include "../../container/variables/vmeasurement.h"
+#include "../../xml/vpattern.h"
 #include "../../tools/vabstracttool.h"
 #include "../../../libs/qmuparser/qmuparsererror.h"
 #include "../../libs/ifc/xml/vdomdocument.h"
@@ -46,6 +48,7 @@
 #include <QSettings>
 #include <QPushButton>
 #include <QDoubleSpinBox>
+#include <algorithm>
 
 Q_LOGGING_CATEGORY(vDialog, "v.dialog")
 
@@ -486,9 +489,7 @@ qreal DialogTool::Eval(const QString &text, bool &flag, QLabel *label, const QSt
             QString formula = text;
             formula.replace("\n", " ");
             formula = qApp->FormulaFromUser(formula);// Translate to internal look.
-            Calculator *cal = new Calculator(data);
-            result = cal->EvalFormula(formula);
-            delete cal;
+            result = Calculator::EvalFormula(data, formula);
 
             //if result equal 0
             if (checkZero && qFuzzyCompare(1 + result, 1 + 0))
@@ -503,7 +504,7 @@ qreal DialogTool::Eval(const QString &text, bool &flag, QLabel *label, const QSt
                 label->setText(qApp->LocaleToString(result) + " " +postfix);
                 flag = true;
                 ChangeColor(labelEditFormula, okColor);
-                label->setToolTip(tr("Value"));
+                label->setToolTip(GradedToolTip(formula));
                 emit ToolTip("");
             }
         }
@@ -674,6 +675,46 @@ void DialogTool::FillList(QComboBox *box, const QMap<QString, quint32> &list) co
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GradedToolTip tooltip for value of formula. For standard measurements also shows range of the value over all
+ * sizes and heights of pattern.
+ * @param formula formula in internal look.
+ */
+QString DialogTool::GradedToolTip(const QString &formula) const
+{
+    const QString toolTip = tr("Value");
+    const VPattern *doc = qApp->getCurrentDocument();
+    if (qApp->patternType() != MeasurementsType::Standard || doc == nullptr)
+    {
+        return toolTip;
+    }
+
+    QVector<qreal> sizes;
+    foreach (const QString &size, VMeasurement::ListSizes(doc->GetGradationSizes()))
+    {
+        sizes.append(size.toDouble());
+    }
+
+    QVector<qreal> heights;
+    foreach (const QString &height, VMeasurement::ListHeights(doc->GetGradationHeights()))
+    {
+        heights.append(height.toDouble());
+    }
+
+    QVector<qreal> values;
+    if (Calculator::EvalFormulaBulk(data, formula, sizes, heights, values) == false || values.isEmpty())
+    {
+        // Value depends on geometry of each size.
+        return toolTip;
+    }
+
+    const qreal min = *std::min_element(values.constBegin(), values.constEnd());
+    const qreal max = *std::max_element(values.constBegin(), values.constEnd());
+    return toolTip + "\n" + tr("From %1 to %2 for all sizes and heights").arg(qApp->LocaleToString(min))
+            .arg(qApp->LocaleToString(max));
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief CheckState enable, when all is correct, or disable, when something wrong, button ok
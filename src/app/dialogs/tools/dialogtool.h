@@ -346,6 +346,7 @@ protected:
     bool             eventFilter(QObject *object, QEvent *event);
 private:
     void             FillList(QComboBox *box, const QMap<QString, quint32> &list)const;
+    QString          GradedToolTip(const QString &formula) const;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
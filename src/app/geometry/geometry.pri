@@ -18,7 +18,9 @@ HEADERS += \
     $$PWD/vspline_p.h \
     $$PWD/vsplinepoint_p.h \
     $$PWD/vsplinepath_p.h \
-    $$PWD/vpointf_p.h
+    $$PWD/vpointf_p.h \
+    $$PWD/vdetailpreparer.h \
+    $$PWD/vcurvecache.h
 
 SOURCES += \
     $$PWD/vsplinepoint.cpp \
@@ -29,4 +31,6 @@ SOURCES += \
     $$PWD/varc.cpp \
     $$PWD/vgobject.cpp \
     $$PWD/vpointf.cpp \
-    $$PWD/vabstractcurve.cpp
+    $$PWD/vabstractcurve.cpp \
+    $$PWD/vdetailpreparer.cpp \
+    $$PWD/vcurvecache.cpp
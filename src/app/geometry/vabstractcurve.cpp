@@ -27,6 +27,7 @@
  *************************************************************************/
 
 #include "vabstractcurve.h"
+#include "../core/vapplication.h"
 
 #include <QPainterPath>
 #include <QDebug>
@@ -52,9 +53,31 @@ VAbstractCurve &VAbstractCurve::operator=(const VAbstractCurve &curve)
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QVector<QPointF> VAbstractCurve::GetSegmentPoints(const QPointF &begin, const QPointF &end, bool reverse) const
+/**
+ * @brief FlattenPoints return points of curve with own tolerance. Curves that can't change count of points return
+ * GetPoints().
+ * @param tolerance maximal distance between curve and its points in pattern units. 0 - default tolerance.
+ */
+QVector<QPointF> VAbstractCurve::FlattenPoints(qreal tolerance) const
+{
+    Q_UNUSED(tolerance);
+    return GetPoints();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CoarseTolerance tolerance in pattern units for layout and preview, where exact curve isn't needed.
+ */
+qreal VAbstractCurve::CoarseTolerance()
+{
+    return qApp->fromPixel(qApp->toPixel(coarseCurveTolerance, Unit::Mm));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VAbstractCurve::GetSegmentPoints(const QPointF &begin, const QPointF &end, bool reverse,
+                                                  qreal tolerance) const
 {
-    QVector<QPointF> points = GetPoints();
+    QVector<QPointF> points = FlattenPoints(tolerance);
     if (reverse)
     {
         points = GetReversePoints(points);
@@ -122,11 +145,21 @@ QVector<QPointF> VAbstractCurve::ToEnd(const QVector<QPointF> &points, const QPo
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QPainterPath VAbstractCurve::GetPath(PathDirection direction) const
+QPainterPath VAbstractCurve::GetPath(PathDirection direction, qreal tolerance) const
+{
+    return PathByPoints(FlattenPoints(tolerance), direction);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PathByPoints make painter path from flattened curve.
+ * @param points points of curve.
+ * @param direction show or hide direction arrows.
+ */
+QPainterPath VAbstractCurve::PathByPoints(const QVector<QPointF> &points, PathDirection direction) const
 {
     QPainterPath path;
 
-    QVector<QPointF> points = GetPoints();
     if (points.count() >= 2)
     {
         for (qint32 i = 0; i < points.count()-1; ++i)
@@ -157,14 +190,31 @@ QVector<QPointF> VAbstractCurve::IntersectLine(const QLineF &line) const
 {
     QVector<QPointF> points = this->GetPoints();
     QVector<QPointF> intersections;
-    for ( qint32 i = 0; i < points.count()-1; ++i )
+    if (points.count() < 2)
     {
-        QPointF crosPoint;
-        QLineF::IntersectType type = line.intersect(QLineF ( points.at(i), points.at(i+1)), &crosPoint);
-        if ( type == QLineF::BoundedIntersection )
+        return intersections;
+    }
+
+    // Segment can cross the line only if its ends lie on different sides. Side is sign of cross product, it much
+    // cheaper than intersection, so most segments of long curve are skipped. Points near the line are checked always.
+    const qreal dx = line.dx();
+    const qreal dy = line.dy();
+    const qreal eps = 1e-8 * qMax(line.length(), 1.0);
+    int previousSide = 0;
+    for ( qint32 i = 0; i < points.count(); ++i )
+    {
+        const qreal cross = dx * (points.at(i).y() - line.y1()) - dy * (points.at(i).x() - line.x1());
+        const int side = qAbs(cross) <= eps ? 0 : (cross > 0 ? 1 : -1);
+        if (i > 0 && (side == 0 || previousSide == 0 || side != previousSide))
         {
-            intersections.append(crosPoint);
+            QPointF crosPoint;
+            QLineF::IntersectType type = line.intersect(QLineF ( points.at(i-1), points.at(i)), &crosPoint);
+            if ( type == QLineF::BoundedIntersection )
+            {
+                intersections.append(crosPoint);
+            }
         }
+        previousSide = side;
     }
     return intersections;
 }
@@ -34,6 +34,9 @@
 
 enum class PathDirection : char { Hide, Show };
 
+/** @brief coarseCurveTolerance maximal distance between curve and its points in millimeters for layout and preview. */
+const qreal coarseCurveTolerance = 0.5;
+
 class QPainterPath;
 class QLineF;
 
@@ -45,13 +48,17 @@ public:
     VAbstractCurve& operator= (const VAbstractCurve &curve);
 
     virtual QVector<QPointF> GetPoints() const =0;
-    QVector<QPointF>         GetSegmentPoints(const QPointF &begin, const QPointF &end, bool reverse = false) const;
+    virtual QVector<QPointF> FlattenPoints(qreal tolerance) const;
+    QVector<QPointF>         GetSegmentPoints(const QPointF &begin, const QPointF &end, bool reverse = false,
+                                              qreal tolerance = 0) const;
 
-    virtual QPainterPath     GetPath(PathDirection direction = PathDirection::Hide) const;
+    virtual QPainterPath     GetPath(PathDirection direction = PathDirection::Hide, qreal tolerance = 0) const;
+    static qreal             CoarseTolerance();
     virtual qreal            GetLength() const =0;
     virtual QVector<QPointF> IntersectLine(const QLineF &line) const;
 protected:
     QPainterPath             ShowDirection(const QVector<QPointF> &points) const;
+    QPainterPath             PathByPoints(const QVector<QPointF> &points, PathDirection direction) const;
 private:
     static QVector<QPointF>  FromBegin(const QVector<QPointF> &points, const QPointF &begin);
     QVector<QPointF>         ToEnd(const QVector<QPointF> &points, const QPointF &end) const;
@@ -164,25 +164,44 @@ qreal VArc::AngleArc() const
 QVector<QPointF> VArc::GetPoints() const
 {
     QVector<QPointF> points;
+    if (d->cache.Points(points))
+    {
+        return points;
+    }
+
+    const QPointF center = d->center.toQPointF();
+    const qreal start = QLineF(center, GetP1()).angle();
     qreal i = 0;
     qreal angle = AngleArc();
     qint32 k = static_cast<qint32>(angle);
     qreal s = angle/(k/4);
+    points.reserve(k/4 + 2);
     do
     {
-        QLineF line(d->center.toQPointF(), GetP1());
-        line.setAngle(line.angle()+i);
-        points.append(line.p2());
+        points.append(PointOnArc(center, start+i));
         i = i + s;
         if (i > angle)
         {
-            QLineF line(d->center.toQPointF(), GetP1());
-            line.setAngle(line.angle()+angle);
-            points.append(line.p2());
+            points.append(PointOnArc(center, start+angle));
         }
     } while (i <= angle);
     // Detail points clockwise, but arc we draw counterclockwise. Main contour need reverse.
-    return GetReversePoints(points);
+    points = GetReversePoints(points);
+    d->cache.SetPoints(points);
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PointOnArc return point of circle with arc radius.
+ * @param center center of circle.
+ * @param angle angle in degree. Counterclockwise like QLineF::angle().
+ */
+QPointF VArc::PointOnArc(const QPointF &center, qreal angle) const
+{
+    const qreal radians = angle * M_PI / 180.0;
+    // Y axis of scene goes down
+    return QPointF(center.x() + d->radius * qCos(radians), center.y() - d->radius * qSin(radians));
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -257,6 +276,7 @@ void VArc::SetFormulaF1(const VFormula &value)
 {
     d->formulaF1 = value.GetFormula(FormulaType::FromUser);
     d->f1 = value.getDoubleValue();
+    d->cache.Clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -284,6 +304,7 @@ void VArc::SetFormulaF2(const VFormula &value)
 {
     d->formulaF2 = value.GetFormula(FormulaType::FromUser);
     d->f2 = value.getDoubleValue();
+    d->cache.Clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -311,6 +332,7 @@ void VArc::SetFormulaRadius(const VFormula &value)
 {
     d->formulaRadius = value.GetFormula(FormulaType::FromUser);
     d->radius = value.getDoubleValue();
+    d->cache.Clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -337,4 +359,5 @@ VPointF VArc::GetCenter() const
 void VArc::SetCenter(const VPointF &value)
 {
     d->center = value;
+    d->cache.Clear();
 }
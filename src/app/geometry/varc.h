@@ -77,6 +77,7 @@ public:
     virtual void       setId(const quint32 &id);
 private:
     QSharedDataPointer<VArcData> d;
+    QPointF            PointOnArc(const QPointF &center, qreal angle) const;
 };
 
 #endif // VARC_H
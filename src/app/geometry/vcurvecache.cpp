@@ -0,0 +1,177 @@
+/************************************************************************
+ **
+ **  @file   vcurvecache.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "vcurvecache.h"
+
+#include <QPolygonF>
+#include <QMutexLocker>
+
+//---------------------------------------------------------------------------------------------------------------------
+VCurveCache::VCurveCache()
+    :mutex(), points(QVector<QPointF>()), coarsePoints(QVector<QPointF>()), rect(QRectF()), length(-1)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+VCurveCache::VCurveCache(const VCurveCache &cache)
+    :mutex(), points(QVector<QPointF>()), coarsePoints(QVector<QPointF>()), rect(QRectF()), length(-1)
+{
+    QMutexLocker locker(&cache.mutex);
+    points = cache.points;
+    coarsePoints = cache.coarsePoints;
+    rect = cache.rect;
+    length = cache.length;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VCurveCache &VCurveCache::operator=(const VCurveCache &cache)
+{
+    if ( &cache == this )
+    {
+        return *this;
+    }
+
+    QVector<QPointF> points;
+    QVector<QPointF> coarsePoints;
+    QRectF rect;
+    qreal length;
+    {
+        QMutexLocker locker(&cache.mutex);
+        points = cache.points;
+        coarsePoints = cache.coarsePoints;
+        rect = cache.rect;
+        length = cache.length;
+    }
+
+    QMutexLocker locker(&mutex);
+    this->points = points;
+    this->coarsePoints = coarsePoints;
+    this->rect = rect;
+    this->length = length;
+    return *this;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Clear forget all values. Call after each change of curve.
+ */
+void VCurveCache::Clear()
+{
+    QMutexLocker locker(&mutex);
+    points.clear();
+    coarsePoints.clear();
+    rect = QRectF();
+    length = -1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Points get flattened curve.
+ * @param points result.
+ * @return false if points were not calculated yet.
+ */
+bool VCurveCache::Points(QVector<QPointF> &points) const
+{
+    QMutexLocker locker(&mutex);
+    if (this->points.isEmpty())
+    {
+        return false;
+    }
+    points = this->points;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VCurveCache::SetPoints(const QVector<QPointF> &points)
+{
+    const QRectF rect = QPolygonF(points).boundingRect();
+
+    QMutexLocker locker(&mutex);
+    this->points = points;
+    this->rect = rect;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CoarsePoints get curve flattened with coarse tolerance. Layout and previews ask for it many times.
+ * @param points result.
+ * @return false if points were not calculated yet.
+ */
+bool VCurveCache::CoarsePoints(QVector<QPointF> &points) const
+{
+    QMutexLocker locker(&mutex);
+    if (coarsePoints.isEmpty())
+    {
+        return false;
+    }
+    points = coarsePoints;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VCurveCache::SetCoarsePoints(const QVector<QPointF> &points)
+{
+    QMutexLocker locker(&mutex);
+    coarsePoints = points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BoundingRect get bounding rectangle of flattened curve.
+ * @return false if points were not calculated yet.
+ */
+bool VCurveCache::BoundingRect(QRectF &rect) const
+{
+    QMutexLocker locker(&mutex);
+    if (points.isEmpty())
+    {
+        return false;
+    }
+    rect = this->rect;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Length get length of curve.
+ * @return false if length was not calculated yet.
+ */
+bool VCurveCache::Length(qreal &length) const
+{
+    QMutexLocker locker(&mutex);
+    if (this->length < 0)
+    {
+        return false;
+    }
+    length = this->length;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VCurveCache::SetLength(qreal length)
+{
+    QMutexLocker locker(&mutex);
+    this->length = length;
+}
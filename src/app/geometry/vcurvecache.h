@@ -0,0 +1,78 @@
+/************************************************************************
+ **
+ **  @file   vcurvecache.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef VCURVECACHE_H
+#define VCURVECACHE_H
+
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <QMutex>
+
+/**
+ * @brief The VCurveCache class keeps geometry of curve between calls.
+ *
+ * Cache lives inside shared data of curve, so copies of curve share it until one of them changes. Owner must clear the
+ * cache in each method that changes shape of curve. Curves from container are read from several threads at the same
+ * time, that's why access is guarded by mutex. Two threads can calculate the same value at once, but result is equal.
+ */
+class VCurveCache
+{
+public:
+    VCurveCache();
+    VCurveCache(const VCurveCache &cache);
+    VCurveCache &operator=(const VCurveCache &cache);
+
+    void Clear();
+
+    bool Points(QVector<QPointF> &points) const;
+    void SetPoints(const QVector<QPointF> &points);
+
+    bool CoarsePoints(QVector<QPointF> &points) const;
+    void SetCoarsePoints(const QVector<QPointF> &points);
+
+    bool BoundingRect(QRectF &rect) const;
+
+    bool Length(qreal &length) const;
+    void SetLength(qreal length);
+
+private:
+    mutable QMutex mutex;
+
+    /** @brief points flattened curve. Empty if not calculated yet. */
+    QVector<QPointF> points;
+
+    /** @brief coarsePoints curve flattened with VAbstractCurve::CoarseTolerance(). Empty if not calculated yet. */
+    QVector<QPointF> coarsePoints;
+
+    /** @brief rect bounding rectangle of points. */
+    QRectF rect;
+
+    /** @brief length length of curve. Negative if not calculated yet. */
+    qreal length;
+};
+
+#endif // VCURVECACHE_H
@@ -358,7 +358,12 @@ QList<quint32> VDetail::Missing(const VDetail &det) const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QVector<QPointF> VDetail::ContourPoints(const VContainer *data) const
+/**
+ * @brief ContourPoints return points of detail contour.
+ * @param data container with objects.
+ * @param tolerance tolerance of curves in pattern units. 0 - default tolerance. See VAbstractCurve::FlattenPoints().
+ */
+QVector<QPointF> VDetail::ContourPoints(const VContainer *data, qreal tolerance) const
 {
     QVector<QPointF> points;
     for (int i = 0; i< CountNode(); ++i)
@@ -380,7 +385,7 @@ QVector<QPointF> VDetail::ContourPoints(const VContainer *data) const
                 const QPointF begin = StartSegment(data, i);
                 const QPointF end = EndSegment(data, i);
 
-                points << curve->GetSegmentPoints(begin, end, at(i).getReverse());
+                points << curve->GetSegmentPoints(begin, end, at(i).getReverse(), tolerance);
             }
             break;
             default:
@@ -392,7 +397,12 @@ QVector<QPointF> VDetail::ContourPoints(const VContainer *data) const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QVector<QPointF> VDetail::SeamAllowancePoints(const VContainer *data) const
+/**
+ * @brief SeamAllowancePoints return points of seam allowance.
+ * @param data container with objects.
+ * @param tolerance tolerance of curves in pattern units. 0 - default tolerance. See VAbstractCurve::FlattenPoints().
+ */
+QVector<QPointF> VDetail::SeamAllowancePoints(const VContainer *data, qreal tolerance) const
 {
     QVector<QPointF> pointsEkv;
     for (int i = 0; i< CountNode(); ++i)
@@ -420,7 +430,7 @@ QVector<QPointF> VDetail::SeamAllowancePoints(const VContainer *data) const
                 const QPointF begin = StartSegment(data, i);
                 const QPointF end = EndSegment(data, i);
 
-                QVector<QPointF> nodePoints = curve->GetSegmentPoints(begin, end, at(i).getReverse());
+                QVector<QPointF> nodePoints = curve->GetSegmentPoints(begin, end, at(i).getReverse(), tolerance);
                 if (getSeamAllowance() == true)
                 {
                     pointsEkv << biasPoints(nodePoints, at(i).getMx(), at(i).getMy());
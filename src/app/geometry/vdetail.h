@@ -78,8 +78,8 @@ public:
 
     QList<quint32> Missing(const VDetail &det) const;
 
-    QVector<QPointF> ContourPoints(const VContainer *data) const;
-    QVector<QPointF> SeamAllowancePoints(const VContainer *data) const;
+    QVector<QPointF> ContourPoints(const VContainer *data, qreal tolerance = 0) const;
+    QVector<QPointF> SeamAllowancePoints(const VContainer *data, qreal tolerance = 0) const;
 
     QPainterPath ContourPath(const VContainer *data) const;
 private:
@@ -0,0 +1,92 @@
+/************************************************************************
+ **
+ **  @file   vdetailpreparer.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "vdetailpreparer.h"
+#include "../container/vcontainer.h"
+#include "vabstractcurve.h"
+#include "../core/vapplication.h"
+#include "exception/vexception.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VDetailPreparer constructor.
+ * @param detail detail of pattern.
+ * @param data container with geometry of pattern. Must not change while preparer works.
+ * @param width width of seam allowance in pixels.
+ */
+VDetailPreparer::VDetailPreparer(const VDetail &detail, const VContainer *data, qreal width)
+    :QRunnable(), detail(detail), data(data), width(width), result(VLayoutDetail()),
+      error(QSharedPointer<VException>()), otherError(nullptr)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VDetailPreparer::run()
+{
+    try
+    {
+        VLayoutDetail det = VLayoutDetail();
+        // Details are exported with exact curves, only search of positions uses coarse outline.
+        det.SetCountourPoints(detail.ContourPoints(data));
+        det.SetSeamAllowencePoints(detail.SeamAllowancePoints(data));
+        det.SetLayoutTolerance(qApp->toPixel(VAbstractCurve::CoarseTolerance()));
+        det.setSeamAllowance(detail.getSeamAllowance());
+        det.setName(detail.getName());
+        det.setWidth(width);
+        result = det;
+    }
+    catch (const VException &e)
+    {
+        // Exception can't leave thread of pool.
+        error = QSharedPointer<VException>(e.clone());
+    }
+    catch (...)
+    {
+        otherError = std::current_exception();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutDetail VDetailPreparer::GetResult() const
+{
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RaiseError raise exception caught during preparing. Does nothing if there was no error.
+ */
+void VDetailPreparer::RaiseError() const
+{
+    if (error.isNull() == false)
+    {
+        error->raise();
+    }
+
+    if (otherError != nullptr)
+    {
+        std::rethrow_exception(otherError);
+    }
+}
@@ -0,0 +1,71 @@
+/************************************************************************
+ **
+ **  @file   vdetailpreparer.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef VDETAILPREPARER_H
+#define VDETAILPREPARER_H
+
+#include <QRunnable>
+#include <QSharedPointer>
+#include <exception>
+
+#include "vdetail.h"
+#include "../libs/vlayout/vlayoutdetail.h"
+
+class VContainer;
+class VException;
+
+/**
+ * @brief The VDetailPreparer class calculates contour and seam allowance of one detail for layout.
+ *
+ * Container is only read, so all details of pattern can be prepared at the same time. If calculation fails the
+ * exception is kept and can be raised again in GUI thread.
+ */
+class VDetailPreparer : public QRunnable
+{
+public:
+    VDetailPreparer(const VDetail &detail, const VContainer *data, qreal width);
+    virtual ~VDetailPreparer(){}
+
+    virtual void run();
+
+    VLayoutDetail GetResult() const;
+    void          RaiseError() const;
+
+private:
+    Q_DISABLE_COPY(VDetailPreparer)
+    const VDetail detail;
+    const VContainer *data;
+
+    /** @brief width width of seam allowance in pixels. */
+    const qreal width;
+    VLayoutDetail result;
+    QSharedPointer<VException> error;
+
+    /** @brief otherError any other exception, for example error of parser. */
+    std::exception_ptr otherError;
+};
+
+#endif // VDETAILPREPARER_H
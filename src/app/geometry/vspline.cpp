@@ -28,6 +28,7 @@
 
 #include "vspline.h"
 #include "vspline_p.h"
+#include "../core/vapplication.h"
 #include <QDebug>
 #include <QPainterPath>
 #include <QtCore/qmath.h>
@@ -93,7 +94,13 @@ VSpline::~VSpline()
  */
 qreal VSpline::GetLength () const
 {
-    return LengthBezier ( GetP1().toQPointF(), d->p2, d->p3, GetP4().toQPointF());
+    qreal length = 0;
+    if (d->cache.Length(length) == false)
+    {
+        length = LengthBezier ( GetP1().toQPointF(), d->p2, d->p3, GetP4().toQPointF());
+        d->cache.SetLength(length);
+    }
+    return length;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -104,31 +111,7 @@ qreal VSpline::LengthT(qreal t) const
         qDebug()<<"Wrong value t.";
         return 0;
     }
-    QLineF seg1_2 ( GetP1 ().toQPointF(), GetP2 () );
-    seg1_2.setLength(seg1_2.length () * t);
-    QPointF p12 = seg1_2.p2();
-
-    QLineF seg2_3 ( GetP2 (), GetP3 () );
-    seg2_3.setLength(seg2_3.length () * t);
-    QPointF p23 = seg2_3.p2();
-
-    QLineF seg12_23 ( p12, p23 );
-    seg12_23.setLength(seg12_23.length () * t);
-    QPointF p123 = seg12_23.p2();
-
-    QLineF seg3_4 ( GetP3 (), GetP4 ().toQPointF() );
-    seg3_4.setLength(seg3_4.length () * t);
-    QPointF p34 = seg3_4.p2();
-
-    QLineF seg23_34 ( p23, p34 );
-    seg23_34.setLength(seg23_34.length () * t);
-    QPointF p234 = seg23_34.p2();
-
-    QLineF seg123_234 ( p123, p234 );
-    seg123_234.setLength(seg123_234.length () * t);
-    QPointF p1234 = seg123_234.p2();
-
-    return LengthBezier ( GetP1().toQPointF(), p12, p123, p1234);
+    return ArcLength(GetP1().toQPointF(), d->p2, d->p3, GetP4().toQPointF(), t);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -145,30 +128,17 @@ qreal VSpline::LengthT(qreal t) const
 QPointF VSpline::CutSpline ( qreal length, QPointF &spl1p2, QPointF &spl1p3, QPointF &spl2p2, QPointF &spl2p3 ) const
 {
     //Always need return two splines, so we must correct wrong length.
-    if (length < GetLength()*0.02)
+    const qreal fullLength = GetLength();
+    if (length < fullLength*0.02)
     {
-        length = GetLength()*0.02;
+        length = fullLength*0.02;
     }
-    else if ( length > GetLength()*0.98)
+    else if ( length > fullLength*0.98)
     {
-        length = GetLength()*0.98;
+        length = fullLength*0.98;
     }
 
-    // Very stupid way find correct value of t.
-    // Better first compare with t = 0.5. Find length of spline.
-    // If length larger, take t = 0.75 and so on.
-    // If length less, take t = 0.25 and so on.
-    qreal parT = 0;
-    qreal step = 0.001;
-    while (1)
-    {
-        parT = parT + step;
-        qreal splLength = LengthT(parT);
-        if (splLength >= length || parT > 1)
-        {
-            break;
-        }
-    }
+    const qreal parT = ParamByLength(length);
 
     QLineF seg1_2 ( GetP1 ().toQPointF(), GetP2 () );
     seg1_2.setLength(seg1_2.length () * parT);
@@ -222,7 +192,13 @@ QPointF VSpline::CutSpline(qreal length, VSpline &spl1, VSpline &spl2) const
  */
 QVector<QPointF> VSpline::GetPoints () const
 {
-    return GetPoints(GetP1().toQPointF(), d->p2, d->p3, GetP4().toQPointF());
+    QVector<QPointF> points;
+    if (d->cache.Points(points) == false)
+    {
+        points = GetPoints(GetP1().toQPointF(), d->p2, d->p3, GetP4().toQPointF());
+        d->cache.SetPoints(points);
+    }
+    return points;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -237,21 +213,82 @@ QVector<QPointF> VSpline::GetPoints () const
 QVector<QPointF> VSpline::GetPoints (const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4)
 {
     QVector<QPointF> pvector;
-    QVector<qreal> x;
-    QVector<qreal> y;
-    QVector<qreal>& wx = x;
-    QVector<qreal>& wy = y;
-    x.append ( p1.x () );
-    y.append ( p1.y () );
-    PointBezier_r ( p1.x (), p1.y (), p2.x (), p2.y (),
-                    p3.x (), p3.y (), p4.x (), p4.y (), 0, wx, wy );
-    x.append ( p4.x () );
-    y.append ( p4.y () );
-    for ( qint32 i = 0; i < x.count(); ++i )
+    AppendPoints(p1, p2, p3, p4, defaultSplineTolerance, pvector);
+    return pvector;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FlattenPoints return points of spline with own tolerance. See AppendPoints().
+ * @param tolerance maximal distance between spline and polyline in pattern units. 0 - cached points of GetPoints().
+ */
+QVector<QPointF> VSpline::FlattenPoints(qreal tolerance) const
+{
+    if (tolerance <= 0)
     {
-        pvector.append( QPointF ( x.at(i), y.at(i)) );
+        return GetPoints();
+    }
+
+    // Layout and previews ask for coarse points again and again.
+    const bool coarse = qFuzzyCompare(tolerance, CoarseTolerance());
+    QVector<QPointF> points;
+    if (coarse && d->cache.CoarsePoints(points))
+    {
+        return points;
+    }
+
+    AppendPoints(points, tolerance);
+    if (coarse)
+    {
+        d->cache.SetCoarsePoints(points);
+    }
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AppendPoints flatten spline and append points to the end of buffer.
+ *
+ * Spline deviates from the polyline not more than tolerance. Big tolerance gives few points, that enough for layout and
+ * preview. See VAbstractCurve::CoarseTolerance().
+ * @param points buffer for points. Existing points stay untouched.
+ * @param tolerance maximal distance between spline and polyline in pattern units. 0 - default tolerance.
+ */
+void VSpline::AppendPoints(QVector<QPointF> &points, qreal tolerance) const
+{
+    AppendPoints(GetP1().toQPointF(), d->p2, d->p3, GetP4().toQPointF(), qApp->toPixel(tolerance), points);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AppendPoints flatten spline by four points and append points to the end of buffer.
+ * @param p1 first spline point.
+ * @param p2 first control point.
+ * @param p3 second control point.
+ * @param p4 last spline point.
+ * @param tolerance maximal distance between spline and polyline in pixels. 0 - default tolerance.
+ * @param points buffer for points.
+ */
+void VSpline::AppendPoints(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4,
+                           qreal tolerance, QVector<QPointF> &points)
+{
+    if (tolerance <= 0)
+    {
+        tolerance = defaultSplineTolerance;
+    }
+
+    const int first = points.size();
+    points.append(p1);
+    PointBezier_r(p1.x(), p1.y(), p2.x(), p2.y(), p3.x(), p3.y(), p4.x(), p4.y(), 0, tolerance*tolerance, points);
+    points.append(p4);
+
+    for (int i = first+1; i < points.size(); ++i)
+    {
+        if (points.at(i-1) == points.at(i))
+        {
+            qCritical("All neighbors points in path must be unique.");
+        }
     }
-    return pvector;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -265,14 +302,133 @@ QVector<QPointF> VSpline::GetPoints (const QPointF &p1, const QPointF &p2, const
  */
 qreal VSpline::LengthBezier ( const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4 )
 {
-    QPainterPath splinePath;
-    QVector<QPointF> points = GetPoints (p1, p2, p3, p4);
-    splinePath.moveTo(points.at(0));
-    for (qint32 i = 1; i < points.count(); ++i)
+    return ArcLength(p1, p2, p3, p4, 1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ArcLength return length of spline from first point to parameter t.
+ *
+ * Length is integral of speed. Gauss-Legendre quadrature is exact for polynomials up to degree 9, so smooth parts of
+ * spline need few evaluations. Interval is halved only near sharp turns.
+ * @param t parameter of spline in range [0; 1].
+ * @return length.
+ */
+qreal VSpline::ArcLength(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t)
+{
+    if (t <= 0)
+    {
+        return 0;
+    }
+    t = qMin(t, 1.0);
+    return ArcLength_r(p1, p2, p3, p4, 0, t, GaussLegendre(p1, p2, p3, p4, 0, t), 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ArcLength_r adaptive quadrature. Interval is split until both halves together give the same length as whole.
+ */
+qreal VSpline::ArcLength_r(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t1,
+                           qreal t2, qreal whole, qint16 level)
+{
+    const qreal lengthTolerance = 0.0001;
+    enum length_recursion_limit_e { length_recursion_limit = 16 };
+
+    const qreal middle = (t1 + t2) / 2;
+    const qreal left = GaussLegendre(p1, p2, p3, p4, t1, middle);
+    const qreal right = GaussLegendre(p1, p2, p3, p4, middle, t2);
+    if (level >= length_recursion_limit || qAbs(left + right - whole) <= lengthTolerance)
     {
-        splinePath.lineTo(points.at(i));
+        return left + right;
     }
-    return splinePath.length();
+
+    return ArcLength_r(p1, p2, p3, p4, t1, middle, left, static_cast<qint16>(level + 1)) +
+           ArcLength_r(p1, p2, p3, p4, middle, t2, right, static_cast<qint16>(level + 1));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GaussLegendre five point Gauss-Legendre quadrature of speed on interval [t1; t2].
+ */
+qreal VSpline::GaussLegendre(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t1,
+                             qreal t2)
+{
+    static const qreal abscissa[] = {0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640,
+                                     0.9061798459386640};
+    static const qreal weight[] = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891,
+                                   0.2369268850561891};
+
+    const qreal half = (t2 - t1) / 2;
+    const qreal center = (t2 + t1) / 2;
+    qreal length = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+        length += weight[i] * Speed(p1, p2, p3, p4, center + half * abscissa[i]);
+    }
+    return length * half;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Speed length of first derivative of spline in point t.
+ */
+qreal VSpline::Speed(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t)
+{
+    const qreal mt = 1 - t;
+    const QPointF derivative = 3*mt*mt*(p2 - p1) + 6*mt*t*(p3 - p2) + 3*t*t*(p4 - p3);
+    return qSqrt(derivative.x()*derivative.x() + derivative.y()*derivative.y());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParamByLength find parameter t where length of spline from first point equals length.
+ *
+ * Newton's method with speed as derivative. If step leaves bracket or speed is zero (cusp) we make bisection step.
+ * @param length length from first point. Must be in range [0; GetLength()].
+ * @return parameter t.
+ */
+qreal VSpline::ParamByLength(qreal length) const
+{
+    const QPointF p1 = GetP1().toQPointF();
+    const QPointF p4 = GetP4().toQPointF();
+    const qreal lengthTolerance = 0.0001;
+    enum newton_iteration_limit_e { newton_iteration_limit = 64 };
+
+    const qreal fullLength = LengthBezier(p1, d->p2, d->p3, p4);
+    if (qFuzzyIsNull(fullLength))
+    {
+        return 0;
+    }
+
+    qreal low = 0;
+    qreal high = 1;
+    qreal t = qBound(0.0, length / fullLength, 1.0);
+    for (int i = 0; i < newton_iteration_limit; ++i)
+    {
+        const qreal error = ArcLength(p1, d->p2, d->p3, p4, t) - length;
+        if (qAbs(error) <= lengthTolerance)
+        {
+            break;
+        }
+
+        if (error > 0)
+        {
+            high = t;
+        }
+        else
+        {
+            low = t;
+        }
+
+        const qreal speed = Speed(p1, d->p2, d->p3, p4, t);
+        qreal next = speed > 0 ? t - error / speed : low;
+        if (next <= low || next >= high)
+        {
+            next = (low + high) / 2;
+        }
+        t = next;
+    }
+    return t;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -287,34 +443,15 @@ qreal VSpline::LengthBezier ( const QPointF &p1, const QPointF &p2, const QPoint
  * @param x4 х coordinate last point.
  * @param y4 у coordinate last point.
  * @param level level of recursion. In the begin 0.
- * @param px list х coordinat spline points.
- * @param py list у coordinat spline points.
+ * @param toleranceSquare squared maximal distance between spline and polyline.
+ * @param points list of spline points.
  */
 void VSpline::PointBezier_r ( qreal x1, qreal y1, qreal x2, qreal y2,
                               qreal x3, qreal y3, qreal x4, qreal y4,
-                              qint16 level, QVector<qreal> &px, QVector<qreal> &py)
+                              qint16 level, qreal toleranceSquare, QVector<QPointF> &points)
 {
-    if (px.size() >= 2)
-    {
-        for (int i=1; i < px.size(); ++i)
-        {
-            if (QPointF(px.at(i-1), py.at(i-1)) == QPointF(px.at(i), py.at(i)))
-            {
-                qCritical("All neighbors points in path must be unique.");
-            }
-        }
-    }
-
     const double curve_collinearity_epsilon                 = 1e-30;
-    const double curve_angle_tolerance_epsilon              = 0.01;
-    const double m_angle_tolerance = 0.0;
     enum curve_recursion_limit_e { curve_recursion_limit = 32 };
-    const double m_cusp_limit = 0.0;
-    double m_approximation_scale = 1.0;
-    double m_distance_tolerance_square;
-
-    m_distance_tolerance_square = 0.5 / m_approximation_scale;
-    m_distance_tolerance_square *= m_distance_tolerance_square;
 
     if (level > curve_recursion_limit)
     {
@@ -406,19 +543,17 @@ void VSpline::PointBezier_r ( qreal x1, qreal y1, qreal x2, qreal y2,
             }
             if (d2 > d3)
             {
-                if (d2 < m_distance_tolerance_square)
+                if (d2 < toleranceSquare)
                 {
-                    px.append(x2);
-                    py.append(y2);
+                    points.append(QPointF(x2, y2));
                     return;
                 }
             }
             else
             {
-                if (d3 < m_distance_tolerance_square)
+                if (d3 < toleranceSquare)
                 {
-                    px.append(x3);
-                    py.append(y3);
+                    points.append(QPointF(x3, y3));
                     return;
                 }
             }
@@ -428,42 +563,10 @@ void VSpline::PointBezier_r ( qreal x1, qreal y1, qreal x2, qreal y2,
         {
             // p1,p2,p4 are collinear, p3 is significant
             //----------------------
-            if (d3 * d3 <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            if (d3 * d3 <= toleranceSquare * (dx*dx + dy*dy))
             {
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                // Angle Condition
-                //----------------------
-                double da1 = fabs(atan2(y4 - y3, x4 - x3) - atan2(y3 - y2, x3 - x2));
-                if (da1 >= M_PI)
-                {
-                    da1 = 2*M_PI - da1;
-                }
-
-                if (da1 < m_angle_tolerance)
-                {
-                    px.append(x2);
-                    py.append(y2);
-
-                    px.append(x3);
-                    py.append(y3);
-                    return;
-                }
-
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
-                    {
-                        px.append(x3);
-                        py.append(y3);
-                        return;
-                    }
-                }
+                points.append(QPointF(x23, y23));
+                return;
             }
             break;
         }
@@ -471,42 +574,10 @@ void VSpline::PointBezier_r ( qreal x1, qreal y1, qreal x2, qreal y2,
         {
             // p1,p3,p4 are collinear, p2 is significant
             //----------------------
-            if (d2 * d2 <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            if (d2 * d2 <= toleranceSquare * (dx*dx + dy*dy))
             {
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                // Angle Condition
-                //----------------------
-                double da1 = fabs(atan2(y3 - y2, x3 - x2) - atan2(y2 - y1, x2 - x1));
-                if (da1 >= M_PI)
-                {
-                    da1 = 2*M_PI - da1;
-                }
-
-                if (da1 < m_angle_tolerance)
-                {
-                    px.append(x2);
-                    py.append(y2);
-
-                    px.append(x3);
-                    py.append(y3);
-                    return;
-                }
-
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
-                    {
-                        px.append(x2);
-                        py.append(y2);
-                        return;
-                    }
-                }
+                points.append(QPointF(x23, y23));
+                return;
             }
             break;
         }
@@ -514,58 +585,12 @@ void VSpline::PointBezier_r ( qreal x1, qreal y1, qreal x2, qreal y2,
         {
             // Regular case
             //-----------------
-            if ((d2 + d3)*(d2 + d3) <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            if ((d2 + d3)*(d2 + d3) <= toleranceSquare * (dx*dx + dy*dy))
             {
-                // If the curvature doesn't exceed the distance_tolerance value
-                // we tend to finish subdivisions.
+                // If the curvature doesn't exceed the tolerance value we tend to finish subdivisions.
                 //----------------------
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                // Angle & Cusp Condition
-                //----------------------
-                const double k   = atan2(y3 - y2, x3 - x2);
-                double da1 = fabs(k - atan2(y2 - y1, x2 - x1));
-                double da2 = fabs(atan2(y4 - y3, x4 - x3) - k);
-                if (da1 >= M_PI)
-                {
-                    da1 = 2*M_PI - da1;
-                }
-                if (da2 >= M_PI)
-                {
-                    da2 = 2*M_PI - da2;
-                }
-
-                if (da1 + da2 < m_angle_tolerance)
-                {
-                    // Finally we can stop the recursion
-                    //----------------------
-
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
-                    {
-                        px.append(x2);
-                        py.append(y2);
-                        return;
-                    }
-
-                    if (da2 > m_cusp_limit)
-                    {
-                        px.append(x3);
-                        py.append(y3);
-                        return;
-                    }
-                }
+                points.append(QPointF(x23, y23));
+                return;
             }
             break;
         }
@@ -575,8 +600,8 @@ void VSpline::PointBezier_r ( qreal x1, qreal y1, qreal x2, qreal y2,
 
     // Continue subdivision
     //----------------------
-    PointBezier_r(x1, y1, x12, y12, x123, y123, x1234, y1234, static_cast<qint16>(level + 1), px, py);
-    PointBezier_r(x1234, y1234, x234, y234, x34, y34, x4, y4, static_cast<qint16>(level + 1), px, py);
+    PointBezier_r(x1, y1, x12, y12, x123, y123, x1234, y1234, static_cast<qint16>(level + 1), toleranceSquare, points);
+    PointBezier_r(x1234, y1234, x234, y234, x34, y34, x4, y4, static_cast<qint16>(level + 1), toleranceSquare, points);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
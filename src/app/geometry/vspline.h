@@ -39,6 +39,9 @@ class VSplineData;
 
 #define M_2PI   6.28318530717958647692528676655900576
 
+/** @brief defaultSplineTolerance maximal distance between spline and its points in pixels if caller doesn't set own. */
+const qreal defaultSplineTolerance = 0.5;
+
 /**
  * @brief VSpline class that implements the spline.
  */
@@ -68,17 +71,28 @@ public:
     QPointF CutSpline ( qreal length, QPointF &spl1p2, QPointF &spl1p3, QPointF &spl2p2, QPointF &spl2p3) const;
     QPointF CutSpline ( qreal length, VSpline &spl1, VSpline &spl2) const;
     QVector<QPointF> GetPoints () const;
+    QVector<QPointF> FlattenPoints(qreal tolerance) const;
+    void    AppendPoints(QVector<QPointF> &points, qreal tolerance) const;
     // cppcheck-suppress unusedFunction
     static QVector<QPointF> SplinePoints(const QPointF &p1, const QPointF &p4, qreal angle1, qreal angle2, qreal kAsm1,
                                          qreal kAsm2, qreal kCurve);
     qreal   ParamT(const QPointF &pBt) const;
+    qreal   ParamByLength(qreal length) const;
 protected:
     static QVector<QPointF> GetPoints (const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4 );
 private:
     QSharedDataPointer<VSplineData> d;
+    static void    AppendPoints(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4,
+                                qreal tolerance, QVector<QPointF> &points);
     static qreal   LengthBezier (const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4 );
+    static qreal   ArcLength(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t);
+    static qreal   ArcLength_r(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t1,
+                               qreal t2, qreal whole, qint16 level);
+    static qreal   GaussLegendre(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t1,
+                                 qreal t2);
+    static qreal   Speed(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t);
     static void    PointBezier_r ( qreal x1, qreal y1, qreal x2, qreal y2, qreal x3, qreal y3, qreal x4, qreal y4,
-                                  qint16 level, QVector<qreal> &px, QVector<qreal> &py);
+                                  qint16 level, qreal toleranceSquare, QVector<QPointF> &points);
     static qreal   CalcSqDistance ( qreal x1, qreal y1, qreal x2, qreal y2);
     void           CreateName();
     QVector<qreal> CalcT(qreal curveCoord1, qreal curveCoord2, qreal curveCoord3, qreal curveCoord4,
@@ -32,6 +32,7 @@
 #include <QSharedData>
 #include "../options.h"
 #include "vpointf.h"
+#include "vcurvecache.h"
 #include <QLineF>
 #include <QtCore/qmath.h>
 
@@ -44,17 +45,18 @@ class VSplineData : public QSharedData
 {
 public:
     VSplineData()
-        :p1(VPointF()), p2(QPointF()), p3(QPointF()), p4(VPointF()), angle1(0), angle2(0), kAsm1(1), kAsm2(1), kCurve(1)
+        :p1(VPointF()), p2(QPointF()), p3(QPointF()), p4(VPointF()), angle1(0), angle2(0), kAsm1(1), kAsm2(1),
+          kCurve(1), cache(VCurveCache())
     {}
 
     VSplineData ( const VSplineData &spline )
         :QSharedData(spline), p1(spline.p1), p2(spline.p2), p3(spline.p3), p4(spline.p4), angle1(spline.angle1),
-          angle2(spline.angle2), kAsm1(spline.kAsm1), kAsm2(spline.kAsm2), kCurve(spline.kCurve)
+          angle2(spline.angle2), kAsm1(spline.kAsm1), kAsm2(spline.kAsm2), kCurve(spline.kCurve), cache(spline.cache)
     {}
 
     VSplineData (VPointF p1, VPointF p4, qreal angle1, qreal angle2, qreal kAsm1, qreal kAsm2, qreal kCurve)
         :p1(p1), p2(QPointF()), p3(QPointF()), p4(p4), angle1(angle1), angle2(angle2), kAsm1(kAsm1), kAsm2(kAsm2),
-          kCurve(kCurve)
+          kCurve(kCurve), cache(VCurveCache())
     {
         qreal L = 0, radius = 0, angle = 90;
         QPointF point1 = this->p1.toQPointF();
@@ -70,7 +72,7 @@ public:
     }
 
     VSplineData (VPointF p1, QPointF p2, QPointF p3, VPointF p4, qreal kCurve)
-        :p1(p1), p2(p2), p3(p3), p4(p4), angle1(0), angle2(0), kAsm1(1), kAsm2(1), kCurve(1)
+        :p1(p1), p2(p2), p3(p3), p4(p4), angle1(0), angle2(0), kAsm1(1), kAsm2(1), kCurve(1), cache(VCurveCache())
     {
         this->angle1 = QLineF ( this->p1.toQPointF(), this->p2 ).angle();
         this->angle2 = QLineF ( this->p4.toQPointF(), this->p3 ).angle();
@@ -114,6 +116,9 @@ public:
 
     /** @brief kCurve coefficient of curvature spline. */
     qreal          kCurve;
+
+    /** @brief cache flattened spline and its length. */
+    mutable VCurveCache cache;
 };
 
 VSplineData::~VSplineData()
@@ -53,6 +53,7 @@ void VSplinePath::append(const VSplinePoint &point)
     }
 
     d->path.append(point);
+    d->cache.Clear();
     QString name = splPath;
     name.append(QString("_%1").arg(d->path.first().P().name()));
     if (d->path.size() > 1)
@@ -92,14 +93,24 @@ VSpline VSplinePath::GetSpline(qint32 index) const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QPainterPath VSplinePath::GetPath(PathDirection direction) const
+/**
+ * @brief GetPath return path of all splines. Each spline gets own direction arrows.
+ *
+ * Points are taken from cache. Flattened spline ends with its last point and the next one begins with the same point,
+ * so two equal neighbour points mark the border between splines.
+ */
+QPainterPath VSplinePath::GetPath(PathDirection direction, qreal tolerance) const
 {
+    const QVector<QPointF> points = FlattenPoints(tolerance);
     QPainterPath painterPath;
-    for (qint32 i = 1; i <= Count(); ++i)
+    int begin = 0;
+    for (int i = 1; i <= points.size(); ++i)
     {
-        VSpline spl(d->path.at(i-1).P(), d->path.at(i).P(), d->path.at(i-1).Angle2(), d->path.at(i).Angle1(),
-                    d->path.at(i-1).KAsm2(), d->path.at(i).KAsm1(), d->kCurve);
-        painterPath.addPath(spl.GetPath(direction));
+        if (i == points.size() || points.at(i) == points.at(i-1))
+        {
+            painterPath.addPath(PathByPoints(points.mid(begin, i - begin), direction));
+            begin = i;
+        }
     }
     return painterPath;
 }
@@ -108,25 +119,71 @@ QPainterPath VSplinePath::GetPath(PathDirection direction) const
 QVector<QPointF> VSplinePath::GetPoints() const
 {
     QVector<QPointF> pathPoints;
+    if (d->cache.Points(pathPoints) == false)
+    {
+        AppendPoints(pathPoints, 0);// Default tolerance
+        d->cache.SetPoints(pathPoints);
+    }
+    return pathPoints;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FlattenPoints return points of path with own tolerance in pattern units. 0 - cached points of GetPoints().
+ */
+QVector<QPointF> VSplinePath::FlattenPoints(qreal tolerance) const
+{
+    if (tolerance <= 0)
+    {
+        return GetPoints();
+    }
+
+    // Layout and previews ask for coarse points again and again.
+    const bool coarse = qFuzzyCompare(tolerance, CoarseTolerance());
+    QVector<QPointF> points;
+    if (coarse && d->cache.CoarsePoints(points))
+    {
+        return points;
+    }
+
+    AppendPoints(points, tolerance);
+    if (coarse)
+    {
+        d->cache.SetCoarsePoints(points);
+    }
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AppendPoints flatten all splines of path into one buffer. See VSpline::AppendPoints().
+ */
+void VSplinePath::AppendPoints(QVector<QPointF> &points, qreal tolerance) const
+{
     for (qint32 i = 1; i <= Count(); ++i)
     {
         VSpline spl(d->path.at(i-1).P(), d->path.at(i).P(), d->path.at(i-1).Angle2(), d->path.at(i).Angle1(),
                     d->path.at(i-1).KAsm2(), d->path.at(i).KAsm1(), d->kCurve);
-        pathPoints += spl.GetPoints();
+        spl.AppendPoints(points, tolerance);
     }
-    return pathPoints;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 qreal VSplinePath::GetLength() const
 {
     qreal length = 0;
+    if (d->cache.Length(length))
+    {
+        return length;
+    }
+
     for (qint32 i = 1; i <= Count(); ++i)
     {
         VSpline spl(d->path.at(i-1).P(), d->path.at(i).P(), d->path.at(i-1).Angle2(), d->path.at(i).Angle1(),
                     d->path.at(i-1).KAsm2(), d->path.at(i).KAsm1(), d->kCurve);
         length += spl.GetLength();
     }
+    d->cache.SetLength(length);
     return length;
 }
 
@@ -145,6 +202,7 @@ void VSplinePath::UpdatePoint(qint32 indexSpline, const SplinePointPosition &pos
     {
         d->path[indexSpline] = point;
     }
+    d->cache.Clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -176,12 +234,6 @@ VSplinePath &VSplinePath::operator =(const VSplinePath &path)
     return *this;
 }
 
-//---------------------------------------------------------------------------------------------------------------------
-VSplinePoint & VSplinePath::operator[](int indx)
-{
-    return d->path[indx];
-}
-
 //---------------------------------------------------------------------------------------------------------------------
 const VSplinePoint &VSplinePath::at(int indx) const
 {
@@ -276,6 +328,7 @@ QVector<VSplinePoint> VSplinePath::GetSplinePath() const
 void VSplinePath::Clear()
 {
     d->path.clear();
+    d->cache.Clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -290,6 +343,7 @@ void VSplinePath::SetKCurve(const qreal &value)
     if (value > 0)
     {
         d->kCurve = value;
+        d->cache.Clear();
     }
 }
 
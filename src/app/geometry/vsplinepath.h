@@ -83,12 +83,20 @@ public:
      * @brief GetPath return QPainterPath which reprezent spline path.
      * @return path.
      */
-    QPainterPath     GetPath(PathDirection direction = PathDirection::Hide) const;
+    QPainterPath     GetPath(PathDirection direction = PathDirection::Hide, qreal tolerance = 0) const;
     /**
      * @brief GetPathPoints return list of points what located on path.
      * @return list.
      */
     QVector<QPointF> GetPoints() const;
+    /**
+     * @brief FlattenPoints return points of path with own tolerance in pattern units.
+     */
+    QVector<QPointF> FlattenPoints(qreal tolerance) const;
+    /**
+     * @brief AppendPoints append points of path to buffer with own tolerance in pattern units.
+     */
+    void             AppendPoints(QVector<QPointF> &points, qreal tolerance) const;
     /**
      * @brief GetSplinePath return list with spline points.
      * @return list.
@@ -138,12 +146,6 @@ public:
      * @return spline path.
      */
     VSplinePath   &operator=(const VSplinePath &path);
-    /**
-     * @brief operator [] return spline point by index.
-     * @param indx index in list.
-     * @return spline point.
-     */
-    VSplinePoint  &operator[](int indx);
     /**
      * @brief at return spline point by index.
      * @param indx index in list.
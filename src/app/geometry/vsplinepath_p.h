@@ -32,6 +32,7 @@
 #include <QSharedData>
 #include "../options.h"
 #include "vsplinepoint.h"
+#include "vcurvecache.h"
 
 #ifdef Q_CC_GNU
     #pragma GCC diagnostic push
@@ -43,15 +44,16 @@ class VSplinePathData : public QSharedData
 public:
 
     VSplinePathData()
-        : path(QVector<VSplinePoint>()), kCurve(1), maxCountPoints(0)
+        : path(QVector<VSplinePoint>()), kCurve(1), maxCountPoints(0), cache(VCurveCache())
     {}
 
     VSplinePathData(qreal kCurve)
-        : path(QVector<VSplinePoint>()), kCurve(kCurve), maxCountPoints(0)
+        : path(QVector<VSplinePoint>()), kCurve(kCurve), maxCountPoints(0), cache(VCurveCache())
     {}
 
     VSplinePathData(const VSplinePathData &splPath)
-        : QSharedData(splPath), path(splPath.path), kCurve(splPath.kCurve), maxCountPoints(splPath.maxCountPoints)
+        : QSharedData(splPath), path(splPath.path), kCurve(splPath.kCurve), maxCountPoints(splPath.maxCountPoints),
+          cache(splPath.cache)
     {}
 
     virtual ~VSplinePathData();
@@ -68,6 +70,10 @@ public:
      * @brief maxCountPoints max count of points what can have spline path.
      */
     qint32        maxCountPoints;
+    /**
+     * @brief cache flattened path and its length.
+     */
+    mutable VCurveCache cache;
 };
 
 VSplinePathData::~VSplinePathData()
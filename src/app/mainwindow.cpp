@@ -43,6 +43,7 @@
 #include "undocommands/renamepp.h"
 #include "vtooloptionspropertybrowser.h"
 #include "options.h"
+#include "geometry/vdetailpreparer.h"
 #include "../libs/ifc/xml/vpatternconverter.h"
 
 #include <QInputDialog>
@@ -62,6 +63,8 @@
 #include <QDesktopServices>
 #include <QLoggingCategory>
 #include <QLockFile>
+#include <QThreadPool>
+#include <algorithm>
 
 Q_LOGGING_CATEGORY(vMainWindow, "v.mainwindow")
 
@@ -1900,19 +1903,43 @@ void MainWindow::ActionLayout(bool checked)
         return;
     }
     hide();//Now we can hide window
-    QHashIterator<quint32, VDetail> idetail(*details);
-    while (idetail.hasNext())
+
+    // Order of hash isn't stable. Keep order of creation, layout will be the same each time.
+    QList<quint32> ids = details->keys();
+    std::sort(ids.begin(), ids.end());
+
+    // Details only read container, so we can calculate them at the same time and keep GUI alive.
+    QThreadPool pool;
+    QVector<VDetailPreparer *> preparers;
+    for (int i = 0; i < ids.size(); ++i)
     {
-        idetail.next();
-        VLayoutDetail det = VLayoutDetail();
-        det.SetCountourPoints(idetail.value().ContourPoints(pattern));
-        det.SetSeamAllowencePoints(idetail.value().SeamAllowancePoints(pattern));
-        det.setSeamAllowance(idetail.value().getSeamAllowance());
-        det.setName(idetail.value().getName());
-        det.setWidth(qApp->toPixel(idetail.value().getWidth()));
+        const VDetail detail = details->value(ids.at(i));
+        VDetailPreparer *preparer = new VDetailPreparer(detail, pattern, qApp->toPixel(detail.getWidth()));
+        preparer->setAutoDelete(false);
+        preparers.append(preparer);
+        pool.start(preparer);
+    }
 
-        listDetails.append(det);
+    while (pool.waitForDone(50) == false)
+    {
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
     }
+
+    try
+    {
+        for (int i = 0; i < preparers.size(); ++i)
+        {
+            preparers.at(i)->RaiseError();
+            listDetails.append(preparers.at(i)->GetResult());
+        }
+    }
+    catch (...)
+    {
+        qDeleteAll(preparers.begin(), preparers.end());
+        throw;
+    }
+    qDeleteAll(preparers.begin(), preparers.end());
+
     QString description = doc->GetDescription();
 
     QString fileName;
@@ -40,6 +40,7 @@
 #include <QtSvg>
 #include <QPrinter>
 #include <QGraphicsScene>
+#include <QEventLoop>
 #include <QtCore/qmath.h>
 
 #ifdef Q_OS_WIN
@@ -55,7 +56,9 @@
  */
 TableWindow::TableWindow(QWidget *parent)
     :QMainWindow(parent), ui(new Ui::TableWindow),
-    listDetails(QVector<VLayoutDetail>()), papers(QList<QGraphicsItem *>()), shadows(QList<QGraphicsItem *>()),
+    listDetails(QVector<VLayoutDetail>()), layoutPapers(QVector<VLayoutPaper>()),
+    layoutDetails(QVector<VLayoutDetail>()), layoutFile(QString()), papers(QList<QGraphicsItem *>()),
+    shadows(QList<QGraphicsItem *>()),
     scenes(QList<QGraphicsScene *>()), details(QList<QList<QGraphicsItem *> >()),fileName(QString()),
     description(QString()), tempScene(nullptr)
 {
@@ -113,6 +116,15 @@ void TableWindow::ModelChosen(QVector<VLayoutDetail> listDetails, const QString
     this->fileName = fi.baseName();
 
     this->listDetails = listDetails;
+
+    // Details are matched by index, so previous layout of other pattern can't be rearranged. For the same pattern
+    // VLayoutGenerator::RearrangeLayout() itself decides if full generation is needed.
+    if (layoutFile != fi.absoluteFilePath())
+    {
+        layoutPapers.clear();
+        layoutDetails.clear();
+        layoutFile = fi.absoluteFilePath();
+    }
     show();
 }
 
@@ -263,24 +275,43 @@ void TableWindow::Layout()
     lGenerator.SetCaseType(layout.GetGroup());
     lGenerator.SetPaperHeight(layout.GetPaperHeight());
     lGenerator.SetPaperWidth(layout.GetPaperWidth());
+    lGenerator.SetRoll(layout.IsRoll());
+    lGenerator.SetPlacement(layout.GetPlacement());
     lGenerator.SetShift(layout.GetShift());
     lGenerator.SetRotate(layout.GetRotate());
     lGenerator.SetRotationIncrease(layout.GetIncrease());
+    lGenerator.SetParallelVariants(layout.GetParallelVariants());
+    lGenerator.SetOptimizationTime(layout.GetOptimizationTime());
 
     DialogLayoutProgress progress(listDetails.count(), this);
 
     connect(&lGenerator, &VLayoutGenerator::Start, &progress, &DialogLayoutProgress::Start);
     connect(&lGenerator, &VLayoutGenerator::Arranged, &progress, &DialogLayoutProgress::Arranged);
+    connect(&lGenerator, &VLayoutGenerator::Optimizing, &progress, &DialogLayoutProgress::Optimizing);
     connect(&lGenerator, &VLayoutGenerator::Error, &progress, &DialogLayoutProgress::Error);
     connect(&lGenerator, &VLayoutGenerator::Finished, &progress, &DialogLayoutProgress::Finished);
     connect(&progress, &DialogLayoutProgress::Abort, &lGenerator, &VLayoutGenerator::Abort);
 
-    lGenerator.Generate();
+    // Layout works in other thread, we only wait for the end and process events.
+    QEventLoop loop;
+    connect(&lGenerator, &VLayoutGenerator::Done, &loop, &QEventLoop::quit);
+
+    if (layoutPapers.isEmpty())
+    {
+        lGenerator.GenerateAsync();
+    }
+    else
+    {
+        lGenerator.RearrangeAsync(layoutPapers, layoutDetails);
+    }
+    loop.exec();
 
     switch (lGenerator.State())
     {
         case LayoutErrors::NoError:
             ClearLayout();
+            layoutPapers = lGenerator.GetPapers();
+            layoutDetails = listDetails;
             papers = lGenerator.GetPapersItems();
             details = lGenerator.GetAllDetails();
             CreateShadows();
@@ -292,7 +323,10 @@ void TableWindow::Layout()
         case LayoutErrors::PrepareLayoutError:
         case LayoutErrors::PaperSizeError:
         case LayoutErrors::EmptyPaperError:
+        case LayoutErrors::TerminatedByException:
             ClearLayout();
+            layoutPapers.clear();
+            layoutDetails.clear();
             break;
         default:
             break;
@@ -34,6 +34,7 @@
 
 #include "../../libs/vlayout/vlayoutdetail.h"
 #include "../../libs/vlayout/vbank.h"
+#include "../../libs/vlayout/vlayoutpaper.h"
 
 namespace Ui
 {
@@ -78,6 +79,15 @@ private:
     /** @brief listDetails list of details. */
     QVector<VLayoutDetail> listDetails;
 
+    /** @brief layoutPapers papers of the last layout. Used for incremental rearrange. */
+    QVector<VLayoutPaper> layoutPapers;
+
+    /** @brief layoutDetails details of the last layout. */
+    QVector<VLayoutDetail> layoutDetails;
+
+    /** @brief layoutFile full path of pattern file of the last layout. */
+    QString               layoutFile;
+
     QList<QGraphicsItem *> papers;
     QList<QGraphicsItem *> shadows;
     QList<QGraphicsScene *> scenes;
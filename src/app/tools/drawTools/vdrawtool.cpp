@@ -230,12 +230,9 @@ qreal VDrawTool::CheckFormula(const quint32 &toolId, QString &formula, VContaine
 {
     SCASSERT(data != nullptr)
     qreal result = 0;
-    Calculator *cal = nullptr;
     try
     {
-        cal = new Calculator(data);
-        result = cal->EvalFormula(formula);
-        delete cal;
+        result = Calculator::EvalFormula(data, formula);
     }
     catch (qmu::QmuParserError &e)
     {
@@ -245,7 +242,6 @@ qreal VDrawTool::CheckFormula(const quint32 &toolId, QString &formula, VContaine
                  << "Message:     " << e.GetMsg()  << "\n"
                  << "Expression:  " << e.GetExpr() << "\n"
                  << "--------------------------------------";
-        delete cal;
 
         DialogUndo *dialogUndo = new DialogUndo(qApp->getMainWindow());
         if (dialogUndo->exec() == QDialog::Accepted)
@@ -263,10 +259,7 @@ qreal VDrawTool::CheckFormula(const quint32 &toolId, QString &formula, VContaine
                     /* Need delete dialog here because parser in dialog don't allow use correct separator for parsing
                      * here. */
                     delete dialog;
-                    Calculator *cal1 = new Calculator(data);
-                    result = cal1->EvalFormula(formula);
-                    delete cal1; /* Here can be memory leak, but dialog already check this formula and probability
-                                  * very low. */
+                    result = Calculator::EvalFormula(data, formula);
                 }
                 else
                 {
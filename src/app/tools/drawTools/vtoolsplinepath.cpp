@@ -120,7 +120,7 @@ VToolSplinePath* VToolSplinePath::Create(DialogTool *dialog, VMainGraphicsScene
     const QString color = dialogTool->GetColor();
     for (qint32 i = 0; i < path->CountPoint(); ++i)
     {
-        doc->IncrementReferens((*path)[i].P().id());
+        doc->IncrementReferens(path->at(i).P().id());
     }
     VToolSplinePath* spl = nullptr;
     spl = Create(0, path, color, scene, doc, data, Document::FullParse, Source::FromGui);
@@ -54,7 +54,8 @@ void VisToolCutSpline::RefreshGeometry()
     if (point1Id > NULL_ID)
     {
         const QSharedPointer<VSpline> spl = Visualization::data->GeometricObject<VSpline>(point1Id);
-        DrawPath(this, spl->GetPath(PathDirection::Show), supportColor, Qt::SolidLine, Qt::RoundCap);
+        DrawPath(this, spl->GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                 supportColor, Qt::SolidLine, Qt::RoundCap);
 
         if (qFuzzyCompare(1 + length, 1 + 0) == false)
         {
@@ -63,8 +64,10 @@ void VisToolCutSpline::RefreshGeometry()
             QPointF p = spl->CutSpline(length, sp1, sp2);
             DrawPoint(point, p, mainColor);
 
-            DrawPath(spl1, sp1.GetPath(PathDirection::Show), Qt::darkGreen, Qt::SolidLine, Qt::RoundCap);
-            DrawPath(spl2, sp2.GetPath(PathDirection::Show), Qt::darkRed, Qt::SolidLine, Qt::RoundCap);
+            DrawPath(spl1, sp1.GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                     Qt::darkGreen, Qt::SolidLine, Qt::RoundCap);
+            DrawPath(spl2, sp2.GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                     Qt::darkRed, Qt::SolidLine, Qt::RoundCap);
         }
     }
 }
@@ -54,7 +54,8 @@ void VisToolCutSplinePath::RefreshGeometry()
     if (point1Id > NULL_ID)
     {
         const QSharedPointer<VSplinePath> splPath = Visualization::data->GeometricObject<VSplinePath>(point1Id);
-        DrawPath(this, splPath->GetPath(PathDirection::Show), supportColor, Qt::SolidLine, Qt::RoundCap);
+        DrawPath(this, splPath->GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                 supportColor, Qt::SolidLine, Qt::RoundCap);
 
         if (qFuzzyCompare(1 + length, 1 + 0) == false)
         {
@@ -109,8 +110,10 @@ void VisToolCutSplinePath::RefreshGeometry()
 
             DrawPoint(point, cutPoint, mainColor);
 
-            DrawPath(splPath1, spPath1.GetPath(PathDirection::Show), Qt::darkGreen, Qt::SolidLine, Qt::RoundCap);
-            DrawPath(splPath2, spPath2.GetPath(PathDirection::Show), Qt::darkRed, Qt::SolidLine, Qt::RoundCap);
+            DrawPath(splPath1, spPath1.GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                     Qt::darkGreen, Qt::SolidLine, Qt::RoundCap);
+            DrawPath(splPath2, spPath2.GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                     Qt::darkRed, Qt::SolidLine, Qt::RoundCap);
         }
     }
 }
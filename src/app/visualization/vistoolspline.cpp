@@ -71,7 +71,8 @@ void VisToolSpline::RefreshGeometry()
             else
             {
                 VSpline spline(*first, *second, angle1, angle2, kAsm1, kAsm2, kCurve);
-                DrawPath(this, spline.GetPath(PathDirection::Show), mainColor, Qt::SolidLine, Qt::RoundCap);
+                DrawPath(this, spline.GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                         mainColor, Qt::SolidLine, Qt::RoundCap);
             }
         }
     }
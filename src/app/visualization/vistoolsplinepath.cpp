@@ -58,7 +58,11 @@ void VisToolSplinePath::RefreshGeometry()
                 QLineF sceneLine = QLineF(pathPoints.at(0).P().toQPointF(), Visualization::scenePos);
                 DrawLine(line, sceneLine, mainColor, lineStyle);
 
-                path[0].SetAngle2(sceneLine.angle());
+                // Path with one point has no splines, so we can't update the point.
+                VSplinePoint first = path.at(0);
+                first.SetAngle2(sceneLine.angle());
+                path.Clear();
+                path.append(first);
                 emit PathChanged(path);
             }
         }
@@ -76,11 +80,14 @@ void VisToolSplinePath::RefreshGeometry()
                                           Visualization::scenePos);
                 DrawLine(line, sceneLine, mainColor, lineStyle);
 
-                path[pathPoints.size() - 1].SetAngle2(sceneLine.angle());
+                VSplinePoint last = path.at(pathPoints.size() - 1);
+                last.SetAngle2(sceneLine.angle());
+                path.UpdatePoint(path.Count(), SplinePointPosition::LastPoint, last);
                 emit PathChanged(path);
             }
 
-            DrawPath(this, path.GetPath(PathDirection::Show), mainColor, Qt::SolidLine, Qt::RoundCap);
+            DrawPath(this, path.GetPath(PathDirection::Show, VAbstractCurve::CoarseTolerance()),
+                     mainColor, Qt::SolidLine, Qt::RoundCap);
         }
         if (path.CountPoint() < 3)
         {
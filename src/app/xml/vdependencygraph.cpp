@@ -0,0 +1,604 @@
+/************************************************************************
+ **
+ **  @file   vdependencygraph.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "vdependencygraph.h"
+#include "vpattern.h"
+#include "../container/vcontainer.h"
+#include "../tools/vtooldetail.h"
+#include "../tools/drawTools/drawtools.h"
+#include "../tools/nodeDetails/nodedetails.h"
+
+#include <QRegExp>
+#include <QTextStream>
+#include <algorithm>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IdAttributes attributes that keep ids of objects an element uses.
+ */
+QStringList IdAttributes()
+{
+    return QStringList() << VAbstractTool::AttrBasePoint << VAbstractTool::AttrFirstPoint
+                         << VAbstractTool::AttrSecondPoint << VAbstractTool::AttrThirdPoint
+                         << VAbstractTool::AttrCenter << VAbstractTool::AttrP1Line << VAbstractTool::AttrP2Line
+                         << VAbstractTool::AttrP1Line1 << VAbstractTool::AttrP2Line1 << VAbstractTool::AttrP1Line2
+                         << VAbstractTool::AttrP2Line2 << VAbstractTool::AttrPShoulder << VAbstractTool::AttrPoint1
+                         << VAbstractTool::AttrPoint4 << VAbstractTool::AttrPSpline << VAbstractTool::AttrAxisP1
+                         << VAbstractTool::AttrAxisP2 << VAbstractTool::AttrCurve << VToolCutArc::AttrArc
+                         << VToolCutSpline::AttrSpline << VToolCutSplinePath::AttrSplinePath
+                         << VAbstractNode::AttrIdObject << VAbstractNode::AttrIdTool;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FormulaAttributes attributes that keep formulas.
+ */
+QStringList FormulaAttributes()
+{
+    return QStringList() << VAbstractTool::AttrLength << VAbstractTool::AttrAngle << VAbstractTool::AttrAngle1
+                         << VAbstractTool::AttrAngle2 << VAbstractTool::AttrRadius;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CollectObjects collect ids of objects from element and all its children.
+ */
+void CollectObjects(const QDomElement &element, const QStringList &idAttributes, QSet<quint32> &objects)
+{
+    for (int i = 0; i < idAttributes.size(); ++i)
+    {
+        if (element.hasAttribute(idAttributes.at(i)))
+        {
+            bool ok = false;
+            const quint32 id = element.attribute(idAttributes.at(i)).toUInt(&ok);
+            if (ok && id != NULL_ID)
+            {
+                objects.insert(id);
+            }
+        }
+    }
+
+    for (QDomElement child = element.firstChildElement(); child.isNull() == false;
+         child = child.nextSiblingElement())
+    {
+        CollectObjects(child, idAttributes, objects);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void CollectFormulas(const QDomElement &element, const QStringList &formulaAttributes, QStringList &formulas)
+{
+    for (int i = 0; i < formulaAttributes.size(); ++i)
+    {
+        if (element.hasAttribute(formulaAttributes.at(i)))
+        {
+            formulas.append(element.attribute(formulaAttributes.at(i)));
+        }
+    }
+
+    for (QDomElement child = element.firstChildElement(); child.isNull() == false;
+         child = child.nextSiblingElement())
+    {
+        CollectFormulas(child, formulaAttributes, formulas);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CollectNames collect name of element and ids of objects it uses from element and all its children. They
+ * define names of objects and variables element creates.
+ */
+void CollectNames(const QDomElement &element, const QStringList &nameAttributes, QStringList &names)
+{
+    for (int i = 0; i < nameAttributes.size(); ++i)
+    {
+        if (element.hasAttribute(nameAttributes.at(i)))
+        {
+            names.append(nameAttributes.at(i) + "=" + element.attribute(nameAttributes.at(i)));
+        }
+    }
+
+    for (QDomElement child = element.firstChildElement(); child.isNull() == false;
+         child = child.nextSiblingElement())
+    {
+        CollectNames(child, nameAttributes, names);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VariableValues base value and increases of all measurements and increments.
+ */
+QHash<QString, QVector<qreal> > VariableValues(const VContainer *data)
+{
+    QHash<QString, QVector<qreal> > values;
+    const QHash<QString, QSharedPointer<VInternalVariable> > *vars = data->DataVariables();
+    QHash<QString, QSharedPointer<VInternalVariable> >::const_iterator i;
+    for (i = vars->constBegin(); i != vars->constEnd(); ++i)
+    {
+        if (i.value()->GetType() == VarType::Measurement || i.value()->GetType() == VarType::Increment)
+        {
+            const QSharedPointer<VVariable> var = qSharedPointerDynamicCast<VVariable>(i.value());
+            if (var.isNull() == false)
+            {
+                values.insert(i.key(), QVector<qreal>() << var->GetBase() << var->GetKsize() << var->GetKheight());
+            }
+        }
+    }
+    return values;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool SameValues(const QVector<qreal> &v1, const QVector<qreal> &v2)
+{
+    if (v1.size() != v2.size())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < v1.size(); ++i)
+    {
+        if (qFuzzyCompare(v1.at(i)+1, v2.at(i)+1) == false)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool IsNodeTag(const QString &tag)
+{
+    return tag == VPattern::TagPoint || tag == VPattern::TagLine || tag == VPattern::TagSpline
+            || tag == VPattern::TagArc || tag == VPattern::TagTools || tag == VToolDetail::TagName;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VDependencyNode::VDependencyNode()
+    :id(NULL_ID), element(QDomElement()), mode(Draw::Calculation), patternPiece(QString()), fingerprint(QString()),
+      names(QStringList()), tools(QVector<quint32>()), variables(QStringList()), unknown(false), opaque(false)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+VDependencyGraph::VDependencyGraph()
+    :nodes(QVector<VDependencyNode>()), ids(QVector<quint32>()), values(QHash<QString, QVector<qreal> >()), size(0),
+      height(0), collecting(false), valid(false)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Begin start collecting graph. Call before full or lite parse.
+ */
+void VDependencyGraph::Begin()
+{
+    Clear();
+    collecting = true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Append add parsed element to graph. Elements must be appended in order of file.
+ * @param element tag in xml tree.
+ * @param mode draw mode of element.
+ * @param patternPiece name of pattern piece.
+ */
+void VDependencyGraph::Append(const QDomElement &element, const Draw &mode, const QString &patternPiece)
+{
+    if (collecting == false || IsNodeTag(element.tagName()) == false)
+    {
+        return;
+    }
+
+    VDependencyNode node;
+    node.id = element.attribute(VDomDocument::AttrId, NULL_ID_STR).toUInt();
+    node.element = element;
+    node.mode = mode;
+    node.patternPiece = patternPiece;
+    // Union of details creates new details and nodes. Only parse can handle this.
+    node.opaque = element.tagName() == VPattern::TagTools;
+    nodes.append(node);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Finish resolve dependencies of collected elements. Call after parse finished successfully.
+ * @param data container with all objects and variables after parse.
+ */
+void VDependencyGraph::Finish(const VContainer *data)
+{
+    if (collecting == false)
+    {
+        return;
+    }
+    collecting = false;
+
+    ids.clear();
+    ids.reserve(nodes.size());
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        ids.append(nodes.at(i).id);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        Update(i, data);
+    }
+    SaveVariables(data);
+    valid = true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VDependencyGraph::Clear()
+{
+    nodes.clear();
+    ids.clear();
+    values.clear();
+    size = 0;
+    height = 0;
+    collecting = false;
+    valid = false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VDependencyGraph::IsValid() const
+{
+    return valid;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VDependencyGraph::Count() const
+{
+    return nodes.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+const VDependencyNode &VDependencyGraph::Node(int i) const
+{
+    return nodes.at(i);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsActual check if file still has the same elements in the same order. Values of attributes don't matter.
+ * @param root root element of pattern file.
+ * @return false if elements were added, removed or moved after graph was collected.
+ */
+bool VDependencyGraph::IsActual(const QDomElement &root) const
+{
+    if (valid == false)
+    {
+        return false;
+    }
+
+    int index = 0;
+    for (QDomElement draw = root.firstChildElement(VPattern::TagDraw); draw.isNull() == false;
+         draw = draw.nextSiblingElement(VPattern::TagDraw))
+    {
+        for (QDomElement mode = draw.firstChildElement(); mode.isNull() == false; mode = mode.nextSiblingElement())
+        {
+            if (mode.tagName() != VPattern::TagCalculation && mode.tagName() != VPattern::TagModeling
+                    && mode.tagName() != VPattern::TagDetails)
+            {
+                continue;
+            }
+
+            for (QDomElement element = mode.firstChildElement(); element.isNull() == false;
+                 element = element.nextSiblingElement())
+            {
+                if (mode.tagName() == VPattern::TagDetails && element.tagName() != VToolDetail::TagName)
+                {
+                    continue;
+                }
+
+                if (IsNodeTag(element.tagName()) == false)
+                {
+                    continue;
+                }
+
+                if (index >= nodes.size() || nodes.at(index).element != element)
+                {
+                    return false;
+                }
+                ++index;
+            }
+        }
+    }
+    return index == nodes.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ChangedVariables find measurements and increments with new values.
+ * @param data container with current values.
+ * @param changed names of changed variables. Size and height names added if they changed.
+ * @return false if variables were added, removed or renamed. Such change requires lite parse.
+ */
+bool VDependencyGraph::ChangedVariables(const VContainer *data, QSet<QString> &changed) const
+{
+    SCASSERT(data != nullptr);
+    const QHash<QString, QVector<qreal> > current = VariableValues(data);
+    if (current.size() != values.size())
+    {
+        return false;
+    }
+
+    const bool gradation = qFuzzyCompare(size+1, VContainer::size()+1) == false ||
+                           qFuzzyCompare(height+1, VContainer::height()+1) == false;
+    if (gradation)
+    {
+        changed.insert(data->SizeName());
+        changed.insert(data->HeightName());
+    }
+
+    QHash<QString, QVector<qreal> >::const_iterator i;
+    for (i = current.constBegin(); i != current.constEnd(); ++i)
+    {
+        if (values.contains(i.key()) == false)
+        {
+            return false;
+        }
+
+        // Values of measurements depend on size and height
+        if (gradation || SameValues(values.value(i.key()), i.value()) == false)
+        {
+            changed.insert(i.key());
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsDirty check if element need recalculation.
+ * @param i index of node.
+ * @param changedTools ids of already recalculated tools.
+ * @param changedVariables names of changed measurements and increments.
+ * @return true if element itself or anything it uses changed.
+ */
+bool VDependencyGraph::IsDirty(int i, const QSet<quint32> &changedTools, const QSet<QString> &changedVariables) const
+{
+    const VDependencyNode &node = nodes.at(i);
+    if (Fingerprint(node.element) != node.fingerprint)
+    {
+        return true;
+    }
+
+    if (node.unknown && (changedTools.isEmpty() == false || changedVariables.isEmpty() == false))
+    {
+        return true;
+    }
+
+    for (int j = 0; j < node.tools.size(); ++j)
+    {
+        if (changedTools.contains(node.tools.at(j)))
+        {
+            return true;
+        }
+    }
+
+    for (int j = 0; j < node.variables.size(); ++j)
+    {
+        if (changedVariables.contains(node.variables.at(j)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsRenamed check if element got other name or uses other objects since last calculation.
+ *
+ * Names of objects and variables (Line_A_B, AngleLine_A_B etc.) element creates depend on them. Recalculation of the
+ * element would add new names and leave old ones in container, so only lite parse can handle such change.
+ */
+bool VDependencyGraph::IsRenamed(int i) const
+{
+    const VDependencyNode &node = nodes.at(i);
+    return Names(node.element) != node.names;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Update remember new state of element after recalculation.
+ * @param i index of node.
+ * @param data container with variables.
+ */
+void VDependencyGraph::Update(int i, const VContainer *data)
+{
+    VDependencyNode &node = nodes[i];
+    node.fingerprint = Fingerprint(node.element);
+    node.names = Names(node.element);
+    Resolve(node, data);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SaveVariables remember values of measurements and increments after recalculation.
+ */
+void VDependencyGraph::SaveVariables(const VContainer *data)
+{
+    SCASSERT(data != nullptr);
+    values = VariableValues(data);
+    size = VContainer::size();
+    height = VContainer::height();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Fingerprint serialize element with children for comparison.
+ */
+QString VDependencyGraph::Fingerprint(const QDomElement &element)
+{
+    QString text;
+    QTextStream stream(&text);
+    element.save(stream, 0);
+    return text;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Formulas all formulas of element and its children.
+ */
+QStringList VDependencyGraph::Formulas(const QDomElement &element)
+{
+    QStringList formulas;
+    CollectFormulas(element, FormulaAttributes(), formulas);
+    return formulas;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Names name of element and ids of objects it uses, with names of attributes.
+ */
+QStringList VDependencyGraph::Names(const QDomElement &element)
+{
+    QStringList names;
+    CollectNames(element, QStringList() << VAbstractTool::AttrName << IdAttributes(), names);
+    return names;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Resolve find tools and variables element depends on.
+ *
+ * Ids of objects from attributes and variables of lengths, angles and curves from formulas are converted to ids of
+ * tools that create these objects.
+ */
+void VDependencyGraph::Resolve(VDependencyNode &node, const VContainer *data) const
+{
+    SCASSERT(data != nullptr);
+
+    // Characters that can't be part of a name. See nameRegExp.
+    static const QRegExp separators("[-*/^+=\\s\\(\\)%:;!.,`'\"<>?&|]+");
+
+    QSet<quint32> objects;
+    CollectObjects(node.element, IdAttributes(), objects);
+
+    const QStringList formulas = Formulas(node.element);
+    QStringList tokens;
+    for (int i = 0; i < formulas.size(); ++i)
+    {
+        tokens.append(formulas.at(i).split(separators, QString::SkipEmptyParts));
+    }
+
+    QSet<QString> variables;
+    node.unknown = false;
+    const QHash<QString, QSharedPointer<VInternalVariable> > *vars = data->DataVariables();
+    for (int i = 0; i < tokens.size(); ++i)
+    {
+        const QString &token = tokens.at(i);
+        if (token.at(0).isDigit() || builInFunctions.contains(token))
+        {
+            continue;
+        }
+
+        if (token == data->SizeName() || token == data->HeightName())
+        {
+            variables.insert(token);
+            continue;
+        }
+
+        if (vars->contains(token) == false)
+        {
+            node.unknown = true;
+            continue;
+        }
+
+        const QSharedPointer<VInternalVariable> var = vars->value(token);
+        switch (var->GetType())
+        {
+            case VarType::Measurement:
+            case VarType::Increment:
+                variables.insert(token);
+                break;
+            case VarType::LineLength:
+            {
+                const QSharedPointer<VLengthLine> line = qSharedPointerDynamicCast<VLengthLine>(var);
+                SCASSERT(line.isNull() == false);
+                objects << line->GetP1Id() << line->GetP2Id();
+                break;
+            }
+            case VarType::LineAngle:
+            {
+                const QSharedPointer<VLineAngle> angle = qSharedPointerDynamicCast<VLineAngle>(var);
+                SCASSERT(angle.isNull() == false);
+                objects << angle->GetP1Id() << angle->GetP2Id();
+                break;
+            }
+            case VarType::SplineLength:
+            case VarType::ArcLength:
+            {
+                const QSharedPointer<VCurveLength> curve = qSharedPointerDynamicCast<VCurveLength>(var);
+                SCASSERT(curve.isNull() == false);
+                objects << curve->GetId() << curve->GetParentId();
+                break;
+            }
+            default:
+                node.unknown = true;
+                break;
+        }
+    }
+
+    QSet<quint32> tools;
+    QSet<quint32>::const_iterator i;
+    for (i = objects.constBegin(); i != objects.constEnd(); ++i)
+    {
+        const quint32 producer = Producer(*i);
+        if (producer != NULL_ID && producer != node.id)
+        {
+            tools.insert(producer);
+        }
+    }
+
+    node.tools = tools.toList().toVector();
+    node.variables = variables.toList();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Producer find tool that created object. Tool takes id for itself and next ids for additional objects (for
+ * example, cut tools create two curves), so this is the nearest id of node that isn't bigger.
+ */
+quint32 VDependencyGraph::Producer(quint32 objectId) const
+{
+    if (objectId == NULL_ID)
+    {
+        return NULL_ID;
+    }
+
+    const QVector<quint32>::const_iterator i = std::upper_bound(ids.constBegin(), ids.constEnd(), objectId);
+    if (i == ids.constBegin())
+    {
+        return NULL_ID;
+    }
+    return *(i - 1);
+}
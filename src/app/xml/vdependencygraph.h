@@ -0,0 +1,131 @@
+/************************************************************************
+ **
+ **  @file   vdependencygraph.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef VDEPENDENCYGRAPH_H
+#define VDEPENDENCYGRAPH_H
+
+#include <QDomElement>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+#include "../options.h"
+
+class VContainer;
+
+/**
+ * @brief The VDependencyNode struct one element of pattern file that creates objects (tool, node or detail).
+ */
+struct VDependencyNode
+{
+    VDependencyNode();
+
+    /** @brief id id of tool. */
+    quint32     id;
+
+    /** @brief element tag in xml tree. */
+    QDomElement element;
+
+    /** @brief mode draw mode of element. */
+    Draw        mode;
+
+    /** @brief patternPiece name of pattern piece that contains element. */
+    QString     patternPiece;
+
+    /** @brief fingerprint serialized element after last calculation. */
+    QString     fingerprint;
+
+    /** @brief names name of element and ids of objects it uses after last calculation. See IsRenamed(). */
+    QStringList names;
+
+    /** @brief tools ids of tools which objects element uses directly or through variables. */
+    QVector<quint32> tools;
+
+    /** @brief variables names of measurements, increments, size and height used in formulas. */
+    QStringList variables;
+
+    /** @brief unknown formula has token we couldn't resolve. Element will be recalculated after any change. */
+    bool        unknown;
+
+    /** @brief opaque element can't be recalculated alone. Any change of it requires lite parse. */
+    bool        opaque;
+};
+
+/**
+ * @brief The VDependencyGraph class dependencies between elements of pattern file.
+ *
+ * Graph collected during full or lite parse. Each node keeps ids of tools which objects the element uses and names of
+ * measurements and increments from its formulas. Variables of lengths, angles and curves resolved to tools that create
+ * their objects. Nodes keep order of file, so all tools a node depends on always before it.
+ *
+ * After change we need recalculate only elements that changed itself or depend on changed tools and variables.
+ */
+class VDependencyGraph
+{
+public:
+    VDependencyGraph();
+
+    void Begin();
+    void Append(const QDomElement &element, const Draw &mode, const QString &patternPiece);
+    void Finish(const VContainer *data);
+    void Clear();
+
+    bool IsValid() const;
+    int  Count() const;
+    const VDependencyNode &Node(int i) const;
+
+    bool IsActual(const QDomElement &root) const;
+    bool ChangedVariables(const VContainer *data, QSet<QString> &changed) const;
+    bool IsDirty(int i, const QSet<quint32> &changedTools, const QSet<QString> &changedVariables) const;
+    bool IsRenamed(int i) const;
+
+    void Update(int i, const VContainer *data);
+    void SaveVariables(const VContainer *data);
+
+    static QString     Fingerprint(const QDomElement &element);
+    static QStringList Formulas(const QDomElement &element);
+    static QStringList Names(const QDomElement &element);
+private:
+    /** @brief nodes elements in order of file. */
+    QVector<VDependencyNode> nodes;
+
+    /** @brief ids sorted ids of nodes. Objects created by a tool have ids right after id of the tool. */
+    QVector<quint32> ids;
+
+    /** @brief values base, size and height increases of measurements and increments after last calculation. */
+    QHash<QString, QVector<qreal> > values;
+
+    qreal   size;
+    qreal   height;
+    bool    collecting;
+    bool    valid;
+
+    void    Resolve(VDependencyNode &node, const VContainer *data) const;
+    quint32 Producer(quint32 objectId) const;
+};
+
+#endif // VDEPENDENCYGRAPH_H
@@ -44,9 +44,11 @@
 #include "vindividualmeasurements.h"
 #include "../../libs/qmuparser/qmuparsererror.h"
 #include "../geometry/varc.h"
+#include "../container/vformulapreparer.h"
 
 #include <QMessageBox>
 #include <QUndoStack>
+#include <QThreadPool>
 #include <QtCore/qmath.h>
 
 const QString VPattern::TagPattern      = QStringLiteral("pattern");
@@ -124,7 +126,7 @@ VPattern::VPattern(VContainer *data, Draw *mode, VMainGraphicsScene *sceneDraw,
                    VMainGraphicsScene *sceneDetail, QObject *parent)
     : QObject(parent), VDomDocument(), data(data), nameActivPP(QString()), tools(QHash<quint32, VDataTool*>()),
       history(QVector<VToolRecord>()), cursor(0), patternPieces(QStringList()), mode(mode), sceneDraw(sceneDraw),
-      sceneDetail(sceneDetail)
+      sceneDetail(sceneDetail), graph(VDependencyGraph())
 {
     SCASSERT(sceneDraw != nullptr);
     SCASSERT(sceneDetail != nullptr);
@@ -321,6 +323,10 @@ void VPattern::Parse(const Document &parse)
     QStringList tags = QStringList() << TagDraw << TagIncrements << TagAuthor << TagDescription << TagNotes
                                         << TagMeasurements << TagVersion << TagGradation;
     PrepareForParse(parse);
+    if (parse == Document::FullParse)
+    {
+        PrepareFormulas();
+    }
     QDomNode domNode = documentElement().firstChild();
     while (domNode.isNull() == false)
     {
@@ -381,6 +387,7 @@ void VPattern::Parse(const Document &parse)
         }
         domNode = domNode.nextSibling();
     }
+    graph.Finish(data);
     emit CheckLayout();
 }
 
@@ -772,7 +779,10 @@ void VPattern::LiteParseTree(const Document &parse)
                 ParseCurrentPP();
                 break;
             case Document::LiteParse:
-                Parse(parse);
+                if (ParseChanges() == false)
+                {
+                    Parse(parse);
+                }
                 break;
             case Document::FullParse:
                 qCWarning(vXML)<<"Lite parsing doesn't support full parsing";
@@ -947,7 +957,6 @@ void VPattern::ParseDrawMode(const QDomNode &node, const Document &parse, const
     {
         scene = sceneDetail;
     }
-    QStringList tags = QStringList() << TagPoint << TagLine << TagSpline << TagArc << TagTools;
     const QDomNodeList nodeList = node.childNodes();
     const qint32 num = nodeList.size();
     for (qint32 i = 0; i < num; ++i)
@@ -955,36 +964,50 @@ void VPattern::ParseDrawMode(const QDomNode &node, const Document &parse, const
         QDomElement domElement = nodeList.at(i).toElement();
         if (domElement.isNull() == false)
         {
-            switch (tags.indexOf(domElement.tagName()))
-            {
-                case 0: // TagPoint
-                    qCDebug(vXML)<<"Tag point.";
-                    ParsePointElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 1: // TagLine
-                    qCDebug(vXML)<<"Tag line.";
-                    ParseLineElement(scene, domElement, parse);
-                    break;
-                case 2: // TagSpline
-                    qCDebug(vXML)<<"Tag spline.";
-                    ParseSplineElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 3: // TagArc
-                    qCDebug(vXML)<<"Tag arc.";
-                    ParseArcElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 4: // TagTools
-                    qCDebug(vXML)<<"Tag tools.";
-                    ParseToolsElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                default:
-                    qCDebug(vXML)<<"Wrong tag name";
-                    break;
-            }
+            ParseDrawModeElement(scene, domElement, parse);
+            graph.Append(domElement, mode, nameActivPP);
         }
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParseDrawModeElement parse one element of draw mode tag.
+ * @param scene scene.
+ * @param domElement tag in xml tree.
+ * @param parse parser file mode.
+ */
+void VPattern::ParseDrawModeElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse)
+{
+    QStringList tags = QStringList() << TagPoint << TagLine << TagSpline << TagArc << TagTools;
+    switch (tags.indexOf(domElement.tagName()))
+    {
+        case 0: // TagPoint
+            qCDebug(vXML)<<"Tag point.";
+            ParsePointElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 1: // TagLine
+            qCDebug(vXML)<<"Tag line.";
+            ParseLineElement(scene, domElement, parse);
+            break;
+        case 2: // TagSpline
+            qCDebug(vXML)<<"Tag spline.";
+            ParseSplineElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 3: // TagArc
+            qCDebug(vXML)<<"Tag arc.";
+            ParseArcElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 4: // TagTools
+            qCDebug(vXML)<<"Tag tools.";
+            ParseToolsElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        default:
+            qCDebug(vXML)<<"Wrong tag name";
+            break;
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief ParseDetailElement parse detail tag.
@@ -1078,6 +1101,7 @@ void VPattern::ParseDetails(const QDomElement &domElement, const Document &parse
                 if (domElement.tagName() == VToolDetail::TagName)
                 {
                     ParseDetailElement(domElement, parse);
+                    graph.Append(domElement, Draw::Modeling, nameActivPP);
                 }
             }
         }
@@ -1687,6 +1711,77 @@ void VPattern::ParseCurrentPP()
     emit CheckLayout();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParseChanges recalculate only changed elements and elements that depend on them.
+ *
+ * Elements are checked in order of file, so when we reach an element all tools it depends on already recalculated.
+ * @return false if graph of dependencies can't be used. In this case need lite parse.
+ */
+bool VPattern::ParseChanges()
+{
+    if (graph.IsActual(documentElement()) == false)
+    {
+        return false;
+    }
+
+    const QDomElement increments = documentElement().firstChildElement(TagIncrements);
+    if (increments.isNull() == false)
+    {
+        ParseIncrementsElement(increments);
+    }
+
+    QSet<QString> changedVariables;
+    if (graph.ChangedVariables(data, changedVariables) == false)
+    {
+        return false;
+    }
+
+    qCDebug(vXML)<<"Parse changes.";
+    QSet<quint32> changedTools;
+    try
+    {
+        for (int i = 0; i < graph.Count(); ++i)
+        {
+            if (graph.IsDirty(i, changedTools, changedVariables) == false)
+            {
+                continue;
+            }
+
+            const VDependencyNode node = graph.Node(i);
+            if (node.opaque || graph.IsRenamed(i))
+            {
+                return false;
+            }
+
+            nameActivPP = node.patternPiece;
+            QDomElement domElement = node.element;
+            if (domElement.tagName() == VToolDetail::TagName)
+            {
+                ParseDetailElement(domElement, Document::LiteParse);
+            }
+            else
+            {
+                VMainGraphicsScene *scene = node.mode == Draw::Calculation ? sceneDraw : sceneDetail;
+                ParseDrawModeElement(scene, domElement, Document::LiteParse);
+            }
+            graph.Update(i, data);
+            changedTools.insert(node.id);
+        }
+    }
+    catch (...)
+    {
+        // Not all dependent elements were recalculated. Next time only lite parse can restore pattern.
+        graph.Clear();
+        throw;
+    }
+
+    graph.SaveVariables(data);
+    qCDebug(vXML)<<"Recalculated"<<changedTools.size()<<"of"<<graph.Count()<<"elements.";
+    emit CheckLayout();
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VPattern::CheckTagExists(const QString &tag)
 {
@@ -2534,6 +2629,11 @@ void VPattern::PrepareForParse(const Document &parse)
 {
     SCASSERT(sceneDraw != nullptr);
     SCASSERT(sceneDetail != nullptr);
+    if (parse == Document::FullParse || parse == Document::LiteParse)
+    {
+        graph.Begin();
+    }
+
     if (parse == Document::FullParse)
     {
         TestUniqueId();
@@ -2557,6 +2657,29 @@ void VPattern::PrepareForParse(const Document &parse)
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PrepareFormulas parse formulas of all pattern pieces at the same time.
+ *
+ * Parsing of formulas takes most time of tools creation, but it doesn't need objects. Pattern pieces share only
+ * measurements and increments, so each piece gets own thread. Later tools only bind cached bytecode to variables.
+ * Objects and scene items are still created one by one in GUI thread.
+ */
+void VPattern::PrepareFormulas()
+{
+    QThreadPool pool;
+    for (QDomElement draw = documentElement().firstChildElement(TagDraw); draw.isNull() == false;
+         draw = draw.nextSiblingElement(TagDraw))
+    {
+        const QStringList formulas = VDependencyGraph::Formulas(draw);
+        if (formulas.isEmpty() == false)
+        {
+            pool.start(new VFormulaPreparer(formulas, data));
+        }
+    }
+    pool.waitForDone();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VPattern::UpdateMeasurements()
 {
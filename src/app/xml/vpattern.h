@@ -31,6 +31,7 @@
 
 #include "../libs/ifc/xml/vdomdocument.h"
 #include "vtoolrecord.h"
+#include "vdependencygraph.h"
 #include "../container/vcontainer.h"
 
 class VDataTool;
@@ -245,9 +246,14 @@ private:
     VMainGraphicsScene *sceneDraw;
     VMainGraphicsScene *sceneDetail;
 
+    /** @brief graph dependencies between elements of file. Allows recalculate only changed part of pattern. */
+    VDependencyGraph graph;
+
     void           SetActivPP(const QString& name);
     void           ParseDrawElement(const QDomNode& node, const Document &parse);
     void           ParseDrawMode(const QDomNode& node, const Document &parse, const Draw &mode);
+    void           ParseDrawModeElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse);
+    bool           ParseChanges();
     void           ParseDetailElement(const QDomElement &domElement,
                                       const Document &parse);
     void           ParseDetails(const QDomElement &domElement, const Document &parse);
@@ -263,6 +269,7 @@ private:
                                      const Document &parse, const QString& type);
     void           ParseIncrementsElement(const QDomNode& node);
     void           PrepareForParse(const Document &parse);
+    void           PrepareFormulas();
     void           UpdateMeasurements();
     void           ToolsCommonAttributes(const QDomElement &domElement, quint32 &id);
     void           PointsCommonAttributes(const QDomElement &domElement, quint32 &id, QString &name, qreal &mx,
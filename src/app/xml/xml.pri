@@ -6,11 +6,13 @@ HEADERS += \
     $$PWD/vpattern.h \
     $$PWD/vstandardmeasurements.h \
     $$PWD/vindividualmeasurements.h \
-    $$PWD/vabstractmeasurements.h
+    $$PWD/vabstractmeasurements.h \
+    $$PWD/vdependencygraph.h
 
 SOURCES += \
     $$PWD/vtoolrecord.cpp \
     $$PWD/vpattern.cpp \
     $$PWD/vstandardmeasurements.cpp \
     $$PWD/vindividualmeasurements.cpp \
-    $$PWD/vabstractmeasurements.cpp
+    $$PWD/vabstractmeasurements.cpp \
+    $$PWD/vdependencygraph.cpp
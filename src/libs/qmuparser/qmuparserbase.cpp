@@ -526,6 +526,23 @@ void QmuParserBase::DefineStrConst(const QString &a_strName, const QString &a_st
     ReInit();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Use ready bytecode instead of parsing expression.
+ *
+ * Bytecode must be created by parser with the same functions and operators. Pointers to variables inside bytecode must
+ * be valid. Set expression with SetExpr() before this call, it is used in error messages.
+ * @param a_ByteCode bytecode of expression.
+ * @param a_nFinalResultIdx number of results of expression. See GetNumResults().
+ */
+void QmuParserBase::SetByteCode(const QmuParserByteCode &a_ByteCode, int a_nFinalResultIdx)
+{
+    m_vRPN = a_ByteCode;
+    m_nFinalResultIdx = a_nFinalResultIdx;
+    m_vStackBuffer.resize(m_vRPN.GetMaxStackSize() * s_MaxNumOpenMPThreads);
+    m_pParseFormula = &QmuParserBase::ParseCmdCode;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Add a user defined variable.
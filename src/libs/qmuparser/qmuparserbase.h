@@ -65,6 +65,8 @@ public:
     void               Eval(qreal *results, int nBulkSize) const;
     int                GetNumResults() const;
     void               SetExpr(const QString &a_sExpr);
+    const QmuParserByteCode& GetByteCode() const;
+    void               SetByteCode(const QmuParserByteCode &a_ByteCode, int a_nFinalResultIdx);
     void               SetVarFactory(facfun_type a_pFactory, void *pUserData = nullptr);
     void               SetDecSep(char_type cDecSep);
     void               SetThousandsSep(char_type cThousandsSep = 0);
@@ -299,6 +301,15 @@ inline const QStringList &QmuParserBase::GetOprtDef()
     return c_DefaultOprt;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Return bytecode of the last evaluated expression. Valid only after successful Eval().
+ */
+inline const QmuParserByteCode &QmuParserBase::GetByteCode() const
+{
+    return m_vRPN;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 inline QMap<int, QString> QmuParserBase::GetTokens() const
 {
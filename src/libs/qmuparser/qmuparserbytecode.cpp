@@ -516,6 +516,80 @@ const SToken* QmuParserByteCode::GetBase() const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Return pointers to variables in order of tokens.
+ *
+ * Together with SetVars() allows to use the same bytecode with other variables that have the same names.
+ */
+QVector<qreal*> QmuParserByteCode::GetVars() const
+{
+    QVector<qreal*> vars;
+    for (int i = 0; i < m_vRPN.size(); ++i)
+    {
+        if (IsVar(m_vRPN.at(i).Cmd))
+        {
+            vars.append(m_vRPN.at(i).Val.ptr);
+        }
+    }
+    return vars;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Replace pointers to variables.
+ * @param vars new pointers in order of GetVars().
+ * @return false if count of pointers is wrong. Bytecode stays unchanged in this case.
+ */
+bool QmuParserByteCode::SetVars(const QVector<qreal*> &vars)
+{
+    int j = 0;
+    for (int i = 0; i < m_vRPN.size(); ++i)
+    {
+        if (IsVar(m_vRPN.at(i).Cmd))
+        {
+            ++j;
+        }
+    }
+
+    if (j != vars.size())
+    {
+        return false;
+    }
+
+    j = 0;
+    for (int i = 0; i < m_vRPN.size(); ++i)
+    {
+        if (IsVar(m_vRPN.at(i).Cmd))
+        {
+            m_vRPN[i].Val.ptr = vars.at(j++);
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Check if bytecode calls string functions. Such bytecode depends on string buffer of parser.
+ */
+bool QmuParserByteCode::HasStrFun() const
+{
+    for (int i = 0; i < m_vRPN.size(); ++i)
+    {
+        if (m_vRPN.at(i).Cmd == cmFUNC_STR)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool QmuParserByteCode::IsVar(ECmdCode a_Cmd)
+{
+    return a_Cmd == cmVAR || a_Cmd == cmVARPOW2 || a_Cmd == cmVARPOW3 || a_Cmd == cmVARPOW4 || a_Cmd == cmVARMUL;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Delete the bytecode.
@@ -105,6 +105,9 @@ public:
     int           GetMaxStackSize() const;
     int           GetSize() const;
     const SToken* GetBase() const;
+    QVector<qreal*> GetVars() const;
+    bool          SetVars(const QVector<qreal*> &vars);
+    bool          HasStrFun() const;
     void          AsciiDump();
 private:
     /** @brief Token type for internal use only. */
@@ -125,6 +128,7 @@ private:
     bool     m_bEnableOptimizer;
 
     void ConstantFolding(ECmdCode a_Oprt);
+    static bool IsVar(ECmdCode a_Cmd);
 };
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -32,6 +32,19 @@
 #include <QVector>
 #include <QPointF>
 #include <QLineF>
+#include <QRectF>
+#include <QHash>
+#include <QPair>
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+// Size of cell for searching equal points. Much bigger than precision of QPointF comparison.
+const qreal duplicateCell = 0.001;
+// Bounding rectangles of segments that touch each other must overlap despite of rounding.
+const qreal loopTolerance = 0.001;
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
@@ -222,30 +235,47 @@ QVector<QPointF> VAbstractDetail::Equidistant(const QVector<QPointF> &points, co
 }
 
 //---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RemoveDublicates remove all repeated points, the first one stays. Points are found through hash, so it takes
+ * linear time.
+ */
 QVector<QPointF> VAbstractDetail::RemoveDublicates(const QVector<QPointF> &points)
 {
-    QVector<QPointF> p = points;
-    for(int i = 0; i < p.size(); i++)
+    QVector<QPointF> p;
+    p.reserve(points.size());
+
+    // Equal points always fall in the same or neighbour cells of grid.
+    QHash<QPair<qint64, qint64>, QVector<int> > cells;
+    cells.reserve(points.size());
+
+    for (int i = 0; i < points.size(); ++i)
     {
-        QPointF current = p.at(i);
+        const QPointF &current = points.at(i);
+        const qint64 cx = static_cast<qint64>(std::floor(current.x()/duplicateCell));
+        const qint64 cy = static_cast<qint64>(std::floor(current.y()/duplicateCell));
 
-        for(int j = i; j < p.size(); j++)
+        bool found = false;
+        for (qint64 x = cx-1; x <= cx+1 && found == false; ++x)
         {
-            if(j == i)
+            for (qint64 y = cy-1; y <= cy+1 && found == false; ++y)
             {
-                continue;
-            }
-            else
-            {
-                QPointF temp = p.at(j);
-                if(current == temp)
+                const QVector<int> cell = cells.value(qMakePair(x, y));
+                for (int k = 0; k < cell.size(); ++k)
                 {
-                    QVector<QPointF>::iterator iter = p.begin() + j;
-                    p.erase(iter);
-                    j--;
+                    if (p.at(cell.at(k)) == current)
+                    {
+                        found = true;
+                        break;
+                    }
                 }
             }
         }
+
+        if (found == false)
+        {
+            cells[qMakePair(cx, cy)].append(p.size());
+            p.append(current);
+        }
     }
 
     return p;
@@ -273,18 +303,35 @@ QVector<QPointF> VAbstractDetail::CorrectEquidistantPoints(const QVector<QPointF
     {
         return correctPoints;
     }
-    //Remove point on line
+    //Remove point on line. After removing we don't check the next point, it stays as is.
+    QVector<QPointF> withoutOnLine;
+    withoutOnLine.reserve(correctPoints.size());
+    withoutOnLine.append(correctPoints.first());
     QPointF point;
-    for (qint32 i = 1; i <correctPoints.size()-1; ++i)
+    int i = 1;
+    while (i < correctPoints.size()-1)
     {
-        QLineF l1(correctPoints.at(i-1), correctPoints.at(i));
+        QLineF l1(withoutOnLine.last(), correctPoints.at(i));
         QLineF l2(correctPoints.at(i), correctPoints.at(i+1));
         QLineF::IntersectType intersect = l1.intersect(l2, &point);
         if (intersect == QLineF::NoIntersection)
         {
-            correctPoints.remove(i);
+            withoutOnLine.append(correctPoints.at(i+1));
+            i += 2;
+        }
+        else
+        {
+            withoutOnLine.append(correctPoints.at(i));
+            ++i;
         }
     }
+
+    for (; i < correctPoints.size(); ++i)
+    {
+        withoutOnLine.append(correctPoints.at(i));
+    }
+    correctPoints = withoutOnLine;
+
     correctPoints = CheckLoops(correctPoints);
     return correctPoints;
 }
@@ -309,6 +356,10 @@ QVector<QPointF> VAbstractDetail::CheckLoops(const QVector<QPointF> &points)
     {
         closed = true;
     }
+
+    // Only segments with overlapping bounding rectangles can intersect.
+    const QVector<QVector<int> > candidates = LoopCandidates(points);
+
     qint32 i, j;
     for (i = 0; i < points.size(); ++i)
     {
@@ -321,8 +372,10 @@ QVector<QPointF> VAbstractDetail::CheckLoops(const QVector<QPointF> &points)
         QPointF crosPoint;
         QLineF::IntersectType intersect = QLineF::NoIntersection;
         QLineF line1(points.at(i), points.at(i+1));
-        for (j = i+2; j < points.size()-1; ++j)
+        const QVector<int> &segments = candidates.at(i);
+        for (int k = 0; k < segments.size(); ++k)
         {
+            j = segments.at(k);
             QLineF line2(points.at(j), points.at(j+1));
             intersect = line1.intersect(line2, &crosPoint);
             if (intersect == QLineF::BoundedIntersection)
@@ -354,6 +407,72 @@ QVector<QPointF> VAbstractDetail::CheckLoops(const QVector<QPointF> &points)
     return ekvPoints;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief LoopCandidates find pairs of segments of polyline that can intersect.
+ *
+ * Sweep line goes along Ox axis through segments sorted by left end. Segment is active until sweep line passes its
+ * right end, so we compare only segments that overlap along both axes.
+ * @param points polyline. Segment i goes from point i to point i+1.
+ * @return for each segment i sorted list of segments j >= i+2 with overlapping bounding rectangles.
+ */
+QVector<QVector<int> > VAbstractDetail::LoopCandidates(const QVector<QPointF> &points)
+{
+    const int n = points.size()-1;
+    QVector<QVector<int> > candidates(qMax(0, n));
+    if (n <= 0)
+    {
+        return candidates;
+    }
+
+    QVector<QRectF> rects(n);
+    QVector<int> order(n);
+    for (int i = 0; i < n; ++i)
+    {
+        rects[i] = QRectF(points.at(i), points.at(i+1)).normalized();
+        order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(), [&rects](int a, int b){return rects.at(a).left() < rects.at(b).left();});
+
+    QVector<int> active;
+    for (int k = 0; k < order.size(); ++k)
+    {
+        const int s = order.at(k);
+        const QRectF &rect = rects.at(s);
+
+        int last = 0;
+        for (int m = 0; m < active.size(); ++m)
+        {
+            const int a = active.at(m);
+            if (rects.at(a).right() + loopTolerance < rect.left())
+            {
+                continue;// Sweep line passed the segment
+            }
+            active[last++] = a;
+
+            if (rects.at(a).top() <= rect.bottom() + loopTolerance &&
+                rect.top() <= rects.at(a).bottom() + loopTolerance)
+            {
+                const int first = qMin(a, s);
+                const int second = qMax(a, s);
+                if (second >= first + 2)
+                {
+                    candidates[first].append(second);
+                }
+            }
+        }
+        active.resize(last);
+        active.append(s);
+    }
+
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        std::sort(candidates[i].begin(), candidates[i].end());
+    }
+    return candidates;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief EkvPoint return vector of points of equidistant two lines. Last point of two lines must be equal.
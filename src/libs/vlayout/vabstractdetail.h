@@ -43,6 +43,7 @@ class QLineF;
  */
 class VAbstractDetail
 {
+    friend class TST_VAbstractDetail;
 public:
     VAbstractDetail();
     VAbstractDetail(const QString &name);
@@ -74,6 +75,7 @@ private:
 
     static QVector<QPointF> CorrectEquidistantPoints(const QVector<QPointF> &points);
     static QVector<QPointF> CheckLoops(const QVector<QPointF> &points);
+    static QVector<QVector<int> > LoopCandidates(const QVector<QPointF> &points);
     static QVector<QPointF> EkvPoint(const QLineF &line1, const QLineF &line2, const qreal &width);
     static QLineF           ParallelLine(const QLineF &line, qreal width );
     static QPointF          SingleParallelPoint(const QLineF &line, const qreal &angle, const qreal &width);
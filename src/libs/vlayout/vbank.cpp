@@ -32,12 +32,40 @@
 #include <QPointF>
 #include <climits>
 #include <QRectF>
+#include <random>
+#include <QRunnable>
+#include <QThreadPool>
+
+namespace
+{
+/**
+ * @brief The VLayoutAllowanceTask class calculates layout allowance of one detail.
+ */
+class VLayoutAllowanceTask : public QRunnable
+{
+public:
+    VLayoutAllowanceTask(VLayoutDetail *detail, qreal width)
+        :QRunnable(), detail(detail), width(width)
+    {}
+
+    virtual void run()
+    {
+        detail->SetLayoutWidth(width);
+        detail->SetLayoutAllowencePoints();
+    }
+
+private:
+    Q_DISABLE_COPY(VLayoutAllowanceTask)
+    VLayoutDetail *detail;
+    qreal width;
+};
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VBank::VBank()
     :details(QVector<VLayoutDetail>()), unsorted(QHash<int, qint64>()), big(QHash<int, qint64>()),
       middle(QHash<int, qint64>()), small(QHash<int, qint64>()), layoutWidth(0), caseType(Cases::CaseDesc),
-      prepare(false), boundingRect(QRectF())
+      order(QVector<int>()), seed(0), priority(QVector<int>()), prepare(false), boundingRect(QRectF())
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -80,6 +108,11 @@ int VBank::GetTiket()
         }
     }
 
+    if (order.isEmpty() == false)
+    {
+        return GetNextByOrder();
+    }
+
     switch(caseType)
     {
         case Cases::CaseThreeGroup:
@@ -106,6 +139,12 @@ VLayoutDetail VBank::GetDetail(int i) const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutDetail> VBank::GetDetails() const
+{
+    return details;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VBank::Arranged(int i)
 {
@@ -168,10 +207,21 @@ bool VBank::Prepare()
         return prepare;
     }
 
+    // Equidistant is expensive for big details. Details are independent, so we calculate them at the same time.
+    VLayoutDetail *data = details.data();
+    QThreadPool pool;
+    for (int i=0; i < details.size(); ++i)
+    {
+        // Details can come from other bank already prepared for this layout width.
+        if (qFuzzyCompare(details.at(i).GetLayoutWidth(), layoutWidth) == false || details.at(i).EdgesCount() == 0)
+        {
+            pool.start(new VLayoutAllowanceTask(data + i, layoutWidth));
+        }
+    }
+    pool.waitForDone();
+
     for (int i=0; i < details.size(); ++i)
     {
-        details[i].SetLayoutWidth(layoutWidth);
-        details[i].SetLayoutAllowencePoints();
         const qint64 square = details.at(i).Square();
         if (square <= 0)
         {
@@ -181,6 +231,7 @@ bool VBank::Prepare()
         unsorted.insert(i, square);
     }
 
+    PreparePriority();
     BiggestBoundingRect();
     PrepareGroup();
 
@@ -205,6 +256,39 @@ void VBank::SetCaseType(Cases caseType)
     this->caseType = caseType;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+Cases VBank::GetCaseType() const
+{
+    return caseType;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetOrder set explicit order of details. Details missed in the list will be given after listed according
+ * to principle of choosing the next workpiece.
+ * @param order numbers of details.
+ */
+void VBank::SetOrder(const QVector<int> &order)
+{
+    this->order = order;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint32 VBank::GetSeed() const
+{
+    return seed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetSeed set seed for choosing between details of one group. The same seed gives the same layout.
+ * @param seed 0 - details go in order they were given.
+ */
+void VBank::SetSeed(quint32 seed)
+{
+    this->seed = seed;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 int VBank::AllDetailsCount() const
 {
@@ -344,20 +428,17 @@ int VBank::GetNextThreeGroups() const
 {
     if (big.isEmpty() == false)
     {
-        QHash<int, qint64>::const_iterator i = big.constBegin();
-        return i.key();
+        return GetFirst(big);
     }
 
     if (middle.isEmpty() == false)
     {
-        QHash<int, qint64>::const_iterator i = middle.constBegin();
-        return i.key();
+        return GetFirst(middle);
     }
 
     if (small.isEmpty() == false)
     {
-        QHash<int, qint64>::const_iterator i = small.constBegin();
-        return i.key();
+        return GetFirst(small);
     }
 
     return -1;
@@ -368,14 +449,12 @@ int VBank::GetNextTwoGroups() const
 {
     if (big.isEmpty() == false)
     {
-        QHash<int, qint64>::const_iterator i = big.constBegin();
-        return i.key();
+        return GetFirst(big);
     }
 
     if (small.isEmpty() == false)
     {
-        QHash<int, qint64>::const_iterator i = small.constBegin();
-        return i.key();
+        return GetFirst(small);
     }
 
     return -1;
@@ -390,7 +469,7 @@ int VBank::GetNextDescGroup() const
     QHash<int, qint64>::const_iterator i = big.constBegin();
     while (i != big.constEnd())
     {
-        if (i.value() > sMax)
+        if (i.value() > sMax || (i.value() == sMax && priority.at(i.key()) < priority.at(index)))
         {
             sMax = i.value();
             index = i.key();
@@ -402,6 +481,52 @@ int VBank::GetNextDescGroup() const
     return index;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetFirst return detail of group with the least priority. Order of hash depends on seeding, so we can't take
+ * the first key.
+ */
+int VBank::GetFirst(const QHash<int, qint64> &group) const
+{
+    int index = -1;
+    QHash<int, qint64>::const_iterator i = group.constBegin();
+    while (i != group.constEnd())
+    {
+        if (index == -1 || priority.at(i.key()) < priority.at(index))
+        {
+            index = i.key();
+        }
+        ++i;
+    }
+    return index;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PreparePriority shuffle details by seed. We don't use std::shuffle, its algorithm differs between standard
+ * libraries.
+ */
+void VBank::PreparePriority()
+{
+    priority.resize(details.size());
+    for (int i = 0; i < priority.size(); ++i)
+    {
+        priority[i] = i;
+    }
+
+    if (seed == 0)
+    {
+        return;
+    }
+
+    std::mt19937 generator(seed);
+    for (int i = priority.size() - 1; i > 0; --i)
+    {
+        const int j = static_cast<int>(generator() % static_cast<quint32>(i + 1));
+        qSwap(priority[i], priority[j]);
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VBank::SqMaxMin(qint64 &sMax, qint64 &sMin) const
 {
@@ -424,3 +549,28 @@ void VBank::SqMaxMin(qint64 &sMax, qint64 &sMin) const
     }
 
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+int VBank::GetNextByOrder() const
+{
+    for (int i = 0; i < order.size(); ++i)
+    {
+        const int index = order.at(i);
+        if (big.contains(index) || middle.contains(index) || small.contains(index))
+        {
+            return index;
+        }
+    }
+
+    switch(caseType)
+    {
+        case Cases::CaseThreeGroup:
+            return GetNextThreeGroups();
+        case Cases::CaseTwoGroup:
+            return GetNextTwoGroups();
+        case Cases::CaseDesc:
+            return GetNextDescGroup();
+        default:
+            return -1;
+    }
+}
@@ -49,6 +49,7 @@ public:
     void SetDetails(const QVector<VLayoutDetail> &details);
     int  GetTiket();
     VLayoutDetail GetDetail(int i) const;
+    QVector<VLayoutDetail> GetDetails() const;
 
     void Arranged(int i);
     void NotArranged(int i);
@@ -56,6 +57,12 @@ public:
     bool Prepare();
     void Reset();
     void SetCaseType(Cases caseType);
+    Cases GetCaseType() const;
+
+    void SetOrder(const QVector<int> &order);
+
+    quint32 GetSeed() const;
+    void    SetSeed(quint32 seed);
 
     int AllDetailsCount() const;
     int LeftArrange() const;
@@ -75,6 +82,16 @@ private:
     qreal layoutWidth;
 
     Cases caseType;
+
+    /** @brief order explicit order of details. If not empty replaces principle of choosing the next workpiece. */
+    QVector<int> order;
+
+    /** @brief seed of shuffling details with equal chances. 0 - keep order of details. */
+    quint32 seed;
+
+    /** @brief priority decides between details of one group. Less value - earlier. Doesn't depend on hash seeding. */
+    QVector<int> priority;
+
     bool prepare;
     QRectF boundingRect;
 
@@ -87,6 +104,9 @@ private:
     int GetNextThreeGroups() const;
     int GetNextTwoGroups() const;
     int GetNextDescGroup() const;
+    int GetNextByOrder() const;
+    int GetFirst(const QHash<int, qint64> &group) const;
+    void PreparePriority();
 
     void SqMaxMin(qint64 &sMax, qint64 &sMin) const;
     void BiggestBoundingRect();
@@ -32,6 +32,78 @@
 
 #include <QPointF>
 #include <QLineF>
+#include <QRectF>
+#include <QtMath>
+
+namespace
+{
+// Max distance in pixels of a removed point from simplified contour. Only rounding errors of cut points, so region of
+// contour doesn't change.
+const qreal simplifyTolerance = 0.001;
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal DistanceToSegment(const QPointF &p, const QPointF &a, const QPointF &b)
+{
+    const qreal dx = b.x() - a.x();
+    const qreal dy = b.y() - a.y();
+    const qreal length2 = dx*dx + dy*dy;
+    if (qFuzzyIsNull(length2))
+    {
+        return QLineF(a, p).length();
+    }
+
+    const qreal t = qBound(0.0, ((p.x() - a.x())*dx + (p.y() - a.y())*dy)/length2, 1.0);
+    return QLineF(p, QPointF(a.x() + t*dx, a.y() + t*dy)).length();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool SamePoint(const QPointF &p1, const QPointF &p2)
+{
+    return QLineF(p1, p2).length() <= simplifyTolerance;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief NormalizedAngle bring angle in radians to range (-pi, pi].
+ */
+qreal NormalizedAngle(qreal angle)
+{
+    while (angle > M_PI)
+    {
+        angle -= 2*M_PI;
+    }
+    while (angle <= -M_PI)
+    {
+        angle += 2*M_PI;
+    }
+    return angle;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CanRemove check if all points between a and c lie on segment a-c.
+ *
+ * Points removed before are checked too, so error of a simplified contour never grows with count of removed points.
+ * @param points all points of contour.
+ * @param from index of a in points.
+ * @param to index of c in points. Can be less than from, contour is closed.
+ */
+bool CanRemove(const QVector<QPointF> &points, int from, int to)
+{
+    const QPointF &a = points.at(from);
+    const QPointF &c = points.at(to);
+
+    const int n = points.size();
+    for (int i = (from + 1) % n; i != to; i = (i + 1) % n)
+    {
+        if (DistanceToSegment(points.at(i), a, c) > simplifyTolerance)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VContour::VContour()
@@ -64,9 +136,36 @@ VContour::~VContour()
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetContour set new global contour.
+ *
+ * Every united detail brings points of all its edges cut by shift. Many of them lie on straight edges of occupied
+ * region or are hidden inside it as spikes of zero width. Without cleaning such points pile up with every detail. We
+ * simplify the contour to corners of the region and cut its edges by shift again, so count of edges stays about
+ * perimeter/shift. Exact contour stays available for the final check of position.
+ */
 void VContour::SetContour(const QVector<QPointF> &contour)
 {
-    d->globalContour = contour;
+    d->exact = contour;
+    const QVector<QPointF> simplified = Simplify(contour);
+    d->globalContour.clear();
+
+    if (d->shift == 0)
+    {
+        d->globalContour = simplified;
+        return;
+    }
+
+    // Restore points for sliding a detail along edge.
+    for (int i = 0; i < simplified.size(); ++i)
+    {
+        const QLineF edge(simplified.at(i), simplified.at((i + 1) % simplified.size()));
+        const QVector<QPointF> points = CutEdge(edge);
+        for (int j = 0; j < points.size()-1; ++j)
+        {
+            d->globalContour.append(points.at(j));
+        }
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -75,6 +174,16 @@ QVector<QPointF> VContour::GetContour() const
     return d->globalContour;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetExactContour return contour as it was set. Covers the same region as global contour without rounding
+ * errors of simplification.
+ */
+QVector<QPointF> VContour::GetExactContour() const
+{
+    return d->exact;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 unsigned int VContour::GetShift() const
 {
@@ -111,6 +220,36 @@ void VContour::SetWidth(int width)
     d->paperWidth = width;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VContour::IsRoll() const
+{
+    return d->roll;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetRoll switch to strip packing. Height of paper is ignored, contour can grow down without limit.
+ */
+void VContour::SetRoll(bool value)
+{
+    d->roll = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Contains check if rectangle is inside of paper. For roll we check only width.
+ */
+bool VContour::Contains(const QRectF &rect) const
+{
+    if (d->roll)
+    {
+        return rect.left() >= 0 && rect.top() >= 0 && rect.right() <= d->paperWidth;
+    }
+
+    const QRectF bRect(0, 0, d->paperWidth, d->paperHeight);
+    return bRect.contains(rect);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QPointF> VContour::UniteWithContour(const VLayoutDetail &detail, int globalI, int detJ, BestFrom type) const
 {
@@ -297,6 +436,155 @@ QVector<QPointF> VContour::CutEdge(const QLineF &edge) const
     return points;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Simplify remove duplicate points, merge collinear runs and remove spikes of zero width of closed polygon.
+ *
+ * Spikes of zero width don't cover any region and are dropped whole. Each point removed from a collinear run is
+ * checked against the final segment that replaces it, not only against its neighbours, so distance between simplified
+ * contour and original contour without spikes is never bigger than tolerance.
+ */
+QVector<QPointF> VContour::Simplify(const QVector<QPointF> &points)
+{
+    // Remove duplicate points and spikes of zero width. A point that walks back to the point before last cancels the
+    // last edge.
+    QVector<QPointF> path;
+    path.reserve(points.size());
+    for (int i = 0; i < points.size(); ++i)
+    {
+        const QPointF &p = points.at(i);
+        if (path.isEmpty() == false && SamePoint(path.last(), p))
+        {
+            continue;
+        }
+
+        if (path.size() >= 2 && SamePoint(path.at(path.size()-2), p))
+        {
+            path.removeLast();
+            continue;
+        }
+        path.append(p);
+    }
+
+    // Polygon is closed, the same near the joint.
+    bool changed = true;
+    while (changed && path.size() >= 3)
+    {
+        changed = false;
+        if (SamePoint(path.last(), path.first()))
+        {
+            path.removeLast();
+            changed = true;
+        }
+        else if (SamePoint(path.last(), path.at(1)))
+        {// Spike at the first point
+            path.removeFirst();
+            path.removeLast();
+            changed = true;
+        }
+        else if (SamePoint(path.at(path.size()-2), path.first()))
+        {// Spike at the last point
+            path.removeLast();
+            path.removeLast();
+            changed = true;
+        }
+    }
+
+    if (path.size() < 3)
+    {
+        return points;// Degenerated polygon, nothing to simplify
+    }
+
+    // Merge collinear runs in one pass. Run starts from the last kept point and grows while its end stays inside the
+    // sleeve of tolerance around every point of the run. Sleeve is kept as a range of allowed directions, so each point
+    // is checked once. End of run must be the farthest point, then distance to the line equals distance to segment.
+    QVector<int> kept;
+    kept.reserve(path.size());
+    kept.append(0);
+    int anchor = 0;
+    bool limited = false;
+    qreal base = 0;// Direction of the first point that limits the range, angles are relative to it.
+    qreal low = 0;
+    qreal high = 0;
+    qreal farthest = 0;
+    int next = 1;
+    while (next < path.size())
+    {
+        const QLineF run(path.at(anchor), path.at(next));
+        const qreal length = run.length();
+        const qreal angle = qAtan2(run.dy(), run.dx());
+
+        bool fits = length >= farthest;
+        if (fits && limited)
+        {
+            const qreal relative = NormalizedAngle(angle - base);
+            fits = relative >= low && relative <= high;
+        }
+
+        if (fits)
+        {
+            farthest = length;
+            if (length > simplifyTolerance)
+            {
+                const qreal delta = qAsin(simplifyTolerance/length);
+                if (limited)
+                {
+                    const qreal relative = NormalizedAngle(angle - base);
+                    low = qMax(low, relative - delta);
+                    high = qMin(high, relative + delta);
+                }
+                else
+                {
+                    limited = true;
+                    base = angle;
+                    low = -delta;
+                    high = delta;
+                }
+            }
+            ++next;
+        }
+        else
+        {
+            anchor = next - 1;
+            kept.append(anchor);
+            limited = false;
+            farthest = 0;
+        }
+    }
+    kept.append(path.size()-1);
+
+    // Check points near the joint. Only few corners can merge here.
+    changed = true;
+    while (changed && kept.size() >= 3)
+    {
+        changed = false;
+        const int n = kept.size();
+        if (CanRemove(path, kept.at(n-2), kept.first()))
+        {
+            kept.removeLast();
+            changed = true;
+        }
+        else if (CanRemove(path, kept.last(), kept.at(1)))
+        {
+            kept.removeFirst();
+            changed = true;
+        }
+    }
+
+    if (kept.size() < 3)
+    {
+        return points;// Degenerated polygon, nothing to simplify
+    }
+
+    QVector<QPointF> result;
+    result.reserve(kept.size());
+    for (int i = 0; i < kept.size(); ++i)
+    {
+        result.append(path.at(kept.at(i)));
+    }
+    return result;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 const QPointF &VContour::at(int i) const
 {
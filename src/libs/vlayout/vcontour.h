@@ -38,6 +38,7 @@ class VContourData;
 class QPointF;
 class VLayoutDetail;
 class QLineF;
+class QRectF;
 
 class VContour
 {
@@ -50,6 +51,7 @@ public:
 
     void SetContour(const QVector<QPointF> &contour);
     QVector<QPointF> GetContour() const;
+    QVector<QPointF> GetExactContour() const;
 
     unsigned int GetShift() const;
     void         SetShift(unsigned int shift);
@@ -60,12 +62,19 @@ public:
     int  GetWidth() const;
     void SetWidth(int width);
 
+    bool IsRoll() const;
+    void SetRoll(bool value);
+
+    bool Contains(const QRectF &rect) const;
+
     QVector<QPointF> UniteWithContour(const VLayoutDetail &detail, int globalI, int detJ, BestFrom type) const;
 
     int    EdgesCount() const;
     QLineF GlobalEdge(int i) const;
     QVector<QPointF> CutEdge(const QLineF &edge) const;
 
+    static QVector<QPointF> Simplify(const QVector<QPointF> &points);
+
     const QPointF &	at(int i) const;
 
 private:
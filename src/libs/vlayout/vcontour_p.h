@@ -41,16 +41,19 @@ class VContourData : public QSharedData
 {
 public:
     VContourData()
-        :globalContour(QVector<QPointF>()), paperHeight(0), paperWidth(0), shift(0)
+        :globalContour(QVector<QPointF>()), exact(QVector<QPointF>()), paperHeight(0), paperWidth(0), shift(0),
+          roll(false)
     {}
 
     VContourData(int height, int width)
-        :globalContour(QVector<QPointF>()), paperHeight(height), paperWidth(width), shift(0)
+        :globalContour(QVector<QPointF>()), exact(QVector<QPointF>()), paperHeight(height), paperWidth(width),
+          shift(0), roll(false)
     {}
 
     VContourData(const VContourData &contour)
-        :QSharedData(contour), globalContour(contour.globalContour), paperHeight(contour.paperHeight),
-          paperWidth(contour.paperWidth), shift(contour.shift)
+        :QSharedData(contour), globalContour(contour.globalContour), exact(contour.exact),
+          paperHeight(contour.paperHeight),
+          paperWidth(contour.paperWidth), shift(contour.shift), roll(contour.roll)
     {}
 
     ~VContourData() {}
@@ -58,6 +61,9 @@ public:
     /** @brief globalContour list of global points contour. */
     QVector<QPointF> globalContour;
 
+    /** @brief exact contour as it was set, before simplification. */
+    QVector<QPointF> exact;
+
     /** @brief paperHeight height of paper in pixels*/
     int paperHeight;
 
@@ -65,6 +71,9 @@ public:
     int paperWidth;
 
     unsigned int shift;
+
+    /** @brief roll paper has fixed width and unlimited height. Contour grows along Oy axis. */
+    bool roll;
 };
 
 #ifdef Q_CC_GNU
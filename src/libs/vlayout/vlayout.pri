@@ -15,7 +15,12 @@ HEADERS += \
     $$PWD/vcontour.h \
     $$PWD/vcontour_p.h \
     $$PWD/vbestsquare.h \
-    $$PWD/vposition.h
+    $$PWD/vposition.h \
+    $$PWD/vspatialindex.h \
+    $$PWD/vlayoutvariant.h \
+    $$PWD/vlayoutstatistics.h \
+    $$PWD/vnofitpolygon.h \
+    $$PWD/vlayoutoptimizer.h
 
 SOURCES += \
     $$PWD/stable.cpp \
@@ -26,4 +31,9 @@ SOURCES += \
     $$PWD/vbank.cpp \
     $$PWD/vcontour.cpp \
     $$PWD/vbestsquare.cpp \
-    $$PWD/vposition.cpp
+    $$PWD/vposition.cpp \
+    $$PWD/vspatialindex.cpp \
+    $$PWD/vlayoutvariant.cpp \
+    $$PWD/vlayoutstatistics.cpp \
+    $$PWD/vnofitpolygon.cpp \
+    $$PWD/vlayoutoptimizer.cpp
@@ -37,7 +37,8 @@ enum class LayoutErrors : char
     PrepareLayoutError,
     PaperSizeError,
     ProcessStoped,
-    EmptyPaperError
+    EmptyPaperError,
+    TerminatedByException
 };
 
 enum class BestFrom : char
@@ -46,6 +47,12 @@ enum class BestFrom : char
     Combine = 1
 };
 
+enum class Placement : char
+{
+    CombineEdges, // Try to combine edges of detail and global contour
+    NoFitPolygon  // Choose the lowest position outside of no-fit polygons
+};
+
 //#define LAYOUT_DEBUG // Enable debug mode
 
 #ifdef LAYOUT_DEBUG
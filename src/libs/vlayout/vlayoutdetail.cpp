@@ -32,6 +32,93 @@
 #include <QGraphicsItem>
 #include <QPainterPath>
 #include <QtMath>
+#include <algorithm>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+qreal DistanceToLine(const QPointF &p, const QPointF &p1, const QPointF &p2)
+{
+    const qreal dx = p2.x() - p1.x();
+    const qreal dy = p2.y() - p1.y();
+    const qreal length = qSqrt(dx*dx + dy*dy);
+    if (qFuzzyIsNull(length))
+    {
+        return QLineF(p, p1).length();
+    }
+    return qAbs(dx * (p.y() - p1.y()) - dy * (p.x() - p1.x())) / length;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ReducePoints remove points of closed contour that lie closer than tolerance to the line between kept
+ * neighbours (Douglas-Peucker). First point and the point farthest from it are always kept.
+ */
+QVector<QPointF> ReducePoints(const QVector<QPointF> &points, qreal tolerance)
+{
+    const int n = points.size();
+    if (tolerance <= 0 || n <= 3)
+    {
+        return points;
+    }
+
+    int farIndex = 0;
+    qreal farDistance = 0;
+    for (int i = 1; i < n; ++i)
+    {
+        const qreal distance = QLineF(points.at(0), points.at(i)).length();
+        if (distance > farDistance)
+        {
+            farDistance = distance;
+            farIndex = i;
+        }
+    }
+
+    QVector<bool> keep(n, false);
+    keep[0] = true;
+    keep[farIndex] = true;
+
+    // Chains of contour are [0, farIndex] and [farIndex, n], where index n means first point again.
+    QVector<QPair<int, int> > stack;
+    stack.append(qMakePair(0, farIndex));
+    stack.append(qMakePair(farIndex, n));
+    while (stack.isEmpty() == false)
+    {
+        const QPair<int, int> chain = stack.takeLast();
+        const QPointF &p1 = points.at(chain.first);
+        const QPointF &p2 = points.at(chain.second % n);
+
+        int index = -1;
+        qreal maxDistance = tolerance;
+        for (int i = chain.first + 1; i < chain.second; ++i)
+        {
+            const qreal distance = DistanceToLine(points.at(i), p1, p2);
+            if (distance > maxDistance)
+            {
+                maxDistance = distance;
+                index = i;
+            }
+        }
+
+        if (index != -1)
+        {
+            keep[index] = true;
+            stack.append(qMakePair(chain.first, index));
+            stack.append(qMakePair(index, chain.second));
+        }
+    }
+
+    QVector<QPointF> reduced;
+    for (int i = 0; i < n; ++i)
+    {
+        if (keep.at(i))
+        {
+            reduced.append(points.at(i));
+        }
+    }
+    return reduced;
+}
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutDetail::VLayoutDetail()
@@ -100,7 +187,13 @@ void VLayoutDetail::SetSeamAllowencePoints(const QVector<QPointF> &points)
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QPointF> VLayoutDetail::GetLayoutAllowencePoints() const
 {
-    return Map(d->layoutAllowence);
+    QVector<QPointF> points;
+    points.reserve(d->transformedX.size());
+    for (int i = 0; i < d->transformedX.size(); ++i)
+    {
+        points.append(QPointF(d->transformedX.at(i), d->transformedY.at(i)));
+    }
+    return points;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -113,6 +206,7 @@ QTransform VLayoutDetail::GetMatrix() const
 void VLayoutDetail::SetMatrix(const QTransform &matrix)
 {
     d->matrix = matrix;
+    UpdateTransformed();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -127,12 +221,30 @@ void VLayoutDetail::SetLayoutWidth(const qreal &value)
     d->layoutWidth = value;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+qreal VLayoutDetail::GetLayoutTolerance() const
+{
+    return d->layoutTolerance;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetLayoutTolerance set how far layout allowence may deviate from the detail. Search of positions doesn't need
+ * exact curves, and less points make it faster. Contour and seam allowence stay exact for export.
+ * @param value tolerance in pixels. 0 - layout allowence follows every point of the detail.
+ */
+void VLayoutDetail::SetLayoutTolerance(const qreal &value)
+{
+    d->layoutTolerance = value;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VLayoutDetail::Translate(qreal dx, qreal dy)
 {
     QTransform m;
     m.translate(dx, dy);
     d->matrix *= m;
+    UpdateTransformed();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -143,6 +255,7 @@ void VLayoutDetail::Rotate(const QPointF &originPoint, qreal degrees)
     m.rotate(-degrees);
     m.translate(-originPoint.x(), -originPoint.y());
     d->matrix *= m;
+    UpdateTransformed();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -175,6 +288,7 @@ void VLayoutDetail::Mirror(const QLineF &edge)
     d->matrix *= m;
 
     d->mirror = !d->mirror;
+    UpdateTransformed();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -191,29 +305,19 @@ QLineF VLayoutDetail::Edge(int i) const
         return QLineF();
     }
 
-    int i1, i2;
-    if (i < EdgesCount())
-    {
-        i1 = i-1;
-        i2 = i;
-    }
-    else
-    {
-        i1 = EdgesCount()-1;
-        i2 = 0;
-    }
+    // Cached points already take into account mirroring.
+    const int i1 = i-1;
+    const int i2 = i < EdgesCount() ? i : 0;
+    return QLineF(d->transformedX.at(i1), d->transformedY.at(i1), d->transformedX.at(i2), d->transformedY.at(i2));
+}
 
-    if (d->mirror)
-    {
-        const int oldI1 = i1;
-        i1 = (d->layoutAllowence.size()-1) - i2;
-        i2 = (d->layoutAllowence.size()-1) - oldI1;
-        return QLineF(d->matrix.map(d->layoutAllowence.at(i2)), d->matrix.map(d->layoutAllowence.at(i1)));
-    }
-    else
-    {
-        return QLineF(d->matrix.map(d->layoutAllowence.at(i1)), d->matrix.map(d->layoutAllowence.at(i2)));
-    }
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief HasNullEdge check if some edge of layout allowence is null. Value is cached for current matrix.
+ */
+bool VLayoutDetail::HasNullEdge() const
+{
+    return d->nullEdge;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -229,10 +333,9 @@ int VLayoutDetail::EdgeByPoint(const QPointF &p1) const
         return 0;
     }
 
-    const QVector<QPointF> points = GetLayoutAllowencePoints();
-    for (int i=0; i< points.size(); i++)
+    for (int i=0; i< d->transformedX.size(); i++)
     {
-        if (points.at(i) == p1)
+        if (QPointF(d->transformedX.at(i), d->transformedY.at(i)) == p1)
         {
             return i+1;
         }
@@ -243,10 +346,16 @@ int VLayoutDetail::EdgeByPoint(const QPointF &p1) const
 //---------------------------------------------------------------------------------------------------------------------
 QRectF VLayoutDetail::BoundingRect() const
 {
-    QVector<QPointF> points = GetLayoutAllowencePoints();
-    points.append(points.first());
-    QRectF rec =  QPolygonF(points).boundingRect();
-    return rec;
+    return d->boundingRect;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetConvexHull return convex hull of layout allowence under current matrix.
+ */
+QVector<QPointF> VLayoutDetail::GetConvexHull() const
+{
+    return d->hull;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -269,6 +378,16 @@ bool VLayoutDetail::isNull() const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsSameShape compare source data of details. Position on sheet doesn't matter.
+ */
+bool VLayoutDetail::IsSameShape(const VLayoutDetail &detail) const
+{
+    return getSeamAllowance() == detail.getSeamAllowance() && qFuzzyCompare(getWidth(), detail.getWidth()) &&
+           d->contour == detail.d->contour && d->seamAllowence == detail.d->seamAllowence;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 qint64 VLayoutDetail::Square() const
 {
@@ -321,9 +440,12 @@ void VLayoutDetail::SetLayoutAllowencePoints()
 {
     if (d->layoutWidth > 0)
     {
+        // Reduced outline may cut a curve by tolerance, wider allowence still keeps whole detail inside.
+        const qreal width = d->layoutWidth + d->layoutTolerance;
         if (getSeamAllowance())
         {
-            d->layoutAllowence = Equidistant(d->seamAllowence, EquidistantType::CloseEquidistant, d->layoutWidth);
+            d->layoutAllowence = Equidistant(ReducePoints(d->seamAllowence, d->layoutTolerance),
+                                             EquidistantType::CloseEquidistant, width);
             if (d->layoutAllowence.isEmpty() == false)
             {
                 d->layoutAllowence.removeLast();
@@ -331,7 +453,8 @@ void VLayoutDetail::SetLayoutAllowencePoints()
         }
         else
         {
-            d->layoutAllowence = Equidistant(d->contour, EquidistantType::CloseEquidistant, d->layoutWidth);
+            d->layoutAllowence = Equidistant(ReducePoints(d->contour, d->layoutTolerance),
+                                             EquidistantType::CloseEquidistant, width);
             if (d->layoutAllowence.isEmpty() == false)
             {
                 d->layoutAllowence.removeLast();
@@ -342,6 +465,9 @@ void VLayoutDetail::SetLayoutAllowencePoints()
     {
         d->layoutAllowence.clear();
     }
+
+    d->layoutHull = ConvexHull(d->layoutAllowence);
+    UpdateTransformed();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -376,6 +502,114 @@ QVector<QPointF> VLayoutDetail::RoundPoints(const QVector<QPointF> &points) cons
     return p;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief UpdateTransformed map layout allowence points and convex hull with current matrix.
+ *
+ * Layout checks each candidate edge by edge, so we keep transformed points in separate arrays of coordinates and
+ * recalculate them only when the matrix changes. Points are stored in the same order as returned
+ * GetLayoutAllowencePoints(), mirroring included.
+ */
+void VLayoutDetail::UpdateTransformed()
+{
+    const int n = d->layoutAllowence.size();
+    d->transformedX.resize(n);
+    d->transformedY.resize(n);
+
+    qreal minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        const QPointF &p = d->layoutAllowence.at(d->mirror ? n-1-i : i);
+        qreal x, y;
+        d->matrix.map(p.x(), p.y(), &x, &y);
+        d->transformedX[i] = x;
+        d->transformedY[i] = y;
+
+        if (i == 0)
+        {
+            minX = maxX = x;
+            minY = maxY = y;
+        }
+        else
+        {
+            minX = qMin(minX, x);
+            maxX = qMax(maxX, x);
+            minY = qMin(minY, y);
+            maxY = qMax(maxY, y);
+        }
+    }
+
+    d->boundingRect = n > 0 ? QRectF(QPointF(minX, minY), QPointF(maxX, maxY)) : QRectF();
+
+    d->nullEdge = false;
+    for (int i = 1; i <= n; ++i)
+    {
+        if (Edge(i).isNull())
+        {
+            d->nullEdge = true;
+            break;
+        }
+    }
+
+    d->hull.clear();
+    d->hull.reserve(d->layoutHull.size());
+    for (int i = 0; i < d->layoutHull.size(); ++i)
+    {
+        d->hull.append(d->matrix.map(d->layoutHull.at(i)));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ConvexHull find convex hull of points (Andrew's monotone chain).
+ * @param points list of points.
+ * @return hull vertices in counterclockwise order.
+ */
+QVector<QPointF> VLayoutDetail::ConvexHull(const QVector<QPointF> &points)
+{
+    if (points.size() < 3)
+    {
+        return points;
+    }
+
+    QVector<QPointF> sorted = points;
+    std::sort(sorted.begin(), sorted.end(), [](const QPointF &p1, const QPointF &p2)
+    {
+        return p1.x() < p2.x() || (!(p2.x() < p1.x()) && p1.y() < p2.y());
+    });
+
+    auto cross = [](const QPointF &o, const QPointF &a, const QPointF &b)
+    {
+        return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+    };
+
+    QVector<QPointF> hull(2*sorted.size());
+    int k = 0;
+
+    // Lower hull
+    for (int i = 0; i < sorted.size(); ++i)
+    {
+        while (k >= 2 && cross(hull.at(k-2), hull.at(k-1), sorted.at(i)) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = sorted.at(i);
+    }
+
+    // Upper hull
+    for (int i = sorted.size()-2, t = k+1; i >= 0; --i)
+    {
+        while (k >= t && cross(hull.at(k-2), hull.at(k-1), sorted.at(i)) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = sorted.at(i);
+    }
+
+    hull.resize(k-1);// Last point is equal to first
+    return hull;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QPainterPath VLayoutDetail::ContourPath() const
 {
@@ -432,4 +666,5 @@ bool VLayoutDetail::IsMirror() const
 void VLayoutDetail::SetMirror(bool value)
 {
     d->mirror = value;
+    UpdateTransformed();
 }
@@ -60,6 +60,9 @@ public:
     qreal GetLayoutWidth() const;
     void  SetLayoutWidth(const qreal &value);
 
+    qreal GetLayoutTolerance() const;
+    void  SetLayoutTolerance(const qreal &value);
+
     bool IsMirror() const;
     void SetMirror(bool value);
 
@@ -70,10 +73,14 @@ public:
     int    EdgesCount() const;
     QLineF Edge(int i) const;
     int    EdgeByPoint(const QPointF &p1) const;
+    bool   HasNullEdge() const;
 
     QRectF BoundingRect() const;
+    QVector<QPointF> GetConvexHull() const;
+    static QVector<QPointF> ConvexHull(const QVector<QPointF> &points);
 
     bool isNull() const;
+    bool IsSameShape(const VLayoutDetail &detail) const;
     qint64 Square() const;
     QPainterPath ContourPath() const;
     QGraphicsItem *GetItem() const;
@@ -83,6 +90,8 @@ private:
 
     QVector<QPointF> Map(const QVector<QPointF> &points) const;
     QVector<QPointF> RoundPoints(const QVector<QPointF> &points) const;
+
+    void UpdateTransformed();
 };
 
 #endif // VLAYOUTDETAIL_H
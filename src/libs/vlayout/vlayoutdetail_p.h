@@ -33,6 +33,7 @@
 #include <QPointF>
 #include <QVector>
 #include <QTransform>
+#include <QRectF>
 
 #ifdef Q_CC_GNU
     #pragma GCC diagnostic push
@@ -44,13 +45,17 @@ class VLayoutDetailData : public QSharedData
 public:
     VLayoutDetailData()
         :contour(QVector<QPointF>()), seamAllowence(QVector<QPointF>()), layoutAllowence(QVector<QPointF>()),
-          matrix(QMatrix()), layoutWidth(0), mirror(false)
+          matrix(QMatrix()), layoutWidth(0), layoutTolerance(0), mirror(false), layoutHull(QVector<QPointF>()),
+          hull(QVector<QPointF>()), boundingRect(QRectF()), transformedX(QVector<qreal>()),
+          transformedY(QVector<qreal>()), nullEdge(false)
     {}
 
     VLayoutDetailData(const VLayoutDetailData &detail)
         :QSharedData(detail), contour(detail.contour), seamAllowence(detail.seamAllowence),
           layoutAllowence(detail.layoutAllowence), matrix(detail.matrix), layoutWidth(detail.layoutWidth),
-          mirror(detail.mirror)
+          layoutTolerance(detail.layoutTolerance), mirror(detail.mirror), layoutHull(detail.layoutHull),
+          hull(detail.hull), boundingRect(detail.boundingRect), transformedX(detail.transformedX),
+          transformedY(detail.transformedY), nullEdge(detail.nullEdge)
     {}
 
     ~VLayoutDetailData() {}
@@ -70,7 +75,28 @@ public:
     /** @brief layoutWidth value layout allowence width in pixels. */
     qreal layoutWidth;
 
+    /** @brief layoutTolerance maximal deviation of layout allowence from the detail in pixels. */
+    qreal layoutTolerance;
+
     bool mirror;
+
+    /** @brief layoutHull convex hull of layout allowence points before transformation. */
+    QVector<QPointF> layoutHull;
+
+    /** @brief hull convex hull of layout allowence points under current matrix. */
+    QVector<QPointF> hull;
+
+    /** @brief boundingRect bounding rectangle of layout allowence points under current matrix. */
+    QRectF boundingRect;
+
+    /** @brief transformedX x coordinates of layout allowence points under current matrix. */
+    QVector<qreal> transformedX;
+
+    /** @brief transformedY y coordinates of layout allowence points under current matrix. */
+    QVector<qreal> transformedY;
+
+    /** @brief nullEdge true if some edge of layout allowence under current matrix is null. */
+    bool nullEdge;
 };
 
 #ifdef Q_CC_GNU
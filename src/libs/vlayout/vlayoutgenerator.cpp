@@ -29,21 +29,94 @@
 #include "vlayoutgenerator.h"
 #include "vlayoutpaper.h"
 #include "vlayoutdetail.h"
+#include "vlayoutvariant.h"
+#include "vlayoutoptimizer.h"
 
 #include <QRectF>
 #include <QImage>
 #include <QDir>
 #include <QGraphicsItem>
+#include <QThreadPool>
+#include <QThread>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <algorithm>
+
+namespace
+{
+// Increase when format of layout result changes.
+const int layoutResultVersion = 3;
+
+//---------------------------------------------------------------------------------------------------------------------
+void AppendRounded(QDataStream &stream, const QVector<QPointF> &points)
+{
+    stream << points.size();
+    for (int i = 0; i < points.size(); ++i)
+    {
+        stream << qRound64(points.at(i).x()*100) << qRound64(points.at(i).y()*100);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ShapeHash hash of detail geometry without transformation. Points are rounded to 0.01 of pixel, so noise of
+ * recalculation doesn't change hash.
+ */
+QString ShapeHash(const VLayoutDetail &detail)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    AppendRounded(stream, detail.GetContourPoints());
+    AppendRounded(stream, detail.GetSeamAllowencePoints());
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief The VLayoutJob class runs asynchronous job of generator.
+ */
+class VLayoutJob : public QRunnable
+{
+public:
+    explicit VLayoutJob(const std::function<void()> &job)
+        :QRunnable(), job(job)
+    {}
+
+    virtual void run()
+    {
+        job();
+    }
+
+private:
+    Q_DISABLE_COPY(VLayoutJob)
+    std::function<void()> job;
+};
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutGenerator::VLayoutGenerator(QObject *parent)
-    :QObject(parent), papers(QVector<VLayoutPaper>()), bank(new VBank()), paperHeight(0), paperWidth(0),
-      stopGeneration(false), state(LayoutErrors::NoError), shift(0), rotate(true), rotationIncrease(180)
-{}
+    :QObject(parent), papers(QVector<VLayoutPaper>()), statistics(VLayoutStatistics()), bank(new VBank()),
+      paperHeight(0), paperWidth(0), roll(false), placement(Placement::CombineEdges), stopGeneration(0),
+      state(LayoutErrors::NoError), shift(0), rotate(true), rotationIncrease(180), parallelVariants(false),
+      optimizationTime(0), jobPool(new QThreadPool()), running(0), seed(0)
+{
+    qRegisterMetaType<LayoutErrors>("LayoutErrors");
+    jobPool->setMaxThreadCount(1);
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutGenerator::~VLayoutGenerator()
 {
+    stopGeneration.store(1);
+    Wait();
+    delete jobPool;
     delete bank;
 }
 
@@ -74,8 +147,28 @@ int VLayoutGenerator::DetailsCount()
 //---------------------------------------------------------------------------------------------------------------------
 void VLayoutGenerator::Generate()
 {
-    stopGeneration = false;
+    stopGeneration.store(0);
+    GenerateLayout();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Rearrange update previous layout after changing of several details. See RearrangeLayout().
+ */
+void VLayoutGenerator::Rearrange(const QVector<VLayoutPaper> &previous, const QVector<VLayoutDetail> &previousDetails)
+{
+    stopGeneration.store(0);
+    RearrangeLayout(previous, previousDetails);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GenerateLayout full generation. Doesn't reset flag of canceling, asynchronous Abort() can come before it.
+ */
+void VLayoutGenerator::GenerateLayout()
+{
     papers.clear();
+    statistics = VLayoutStatistics();
     state = LayoutErrors::NoError;
 
 #ifdef LAYOUT_DEBUG
@@ -90,62 +183,547 @@ void VLayoutGenerator::Generate()
     if (bank->Prepare())
     {
         CheckDetailsSize();
-        while (bank->AllDetailsCount() > 0)
+        if (stopGeneration.load() == 0)
         {
-            if (stopGeneration)
+            const QVector<VLayoutVariant *> variants = CreateVariants();
+            RunVariants(variants);
+            qDeleteAll(variants.begin(), variants.end());
+
+            if (state != LayoutErrors::NoError && state != LayoutErrors::ProcessStoped)
             {
-                break;
+                return;
             }
 
-            VLayoutPaper paper(paperHeight, paperWidth);
-            paper.SetShift(shift);
-            paper.SetLayoutWidth(bank->GetLayoutWidth());
-            paper.SetPaperIndex(papers.count());
-            paper.SetRotate(rotate);
-            paper.SetRotationIncrease(rotationIncrease);
-            do
+            if (optimizationTime > 0 && stopGeneration.load() == 0)
             {
-                const int index = bank->GetTiket();
-                if (paper.ArrangeDetail(bank->GetDetail(index), stopGeneration))
+                Optimize();
+            }
+        }
+    }
+    else
+    {
+        state = LayoutErrors::PrepareLayoutError;
+        emit Error(state);
+        return;
+    }
+
+    if (stopGeneration.load() != 0 && state == LayoutErrors::NoError)
+    {
+        state = LayoutErrors::ProcessStoped;// Was canceled by asynchronous Abort()
+    }
+    emit Finished();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GenerateAsync start Generate() in other thread and return immediately.
+ *
+ * Signals come to objects of GUI thread through queue, so event loop must run. Signal Done() is always the last. Until
+ * it comes don't change settings and don't read results. Cancel job by Abort(), workers check the flag after each
+ * candidate position, so job stops quickly. Sheets finished before canceling stay available by GetPapers().
+ */
+void VLayoutGenerator::GenerateAsync()
+{
+    StartJob([this](){GenerateLayout();});
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RearrangeAsync start Rearrange() in other thread and return immediately. See GenerateAsync().
+ */
+void VLayoutGenerator::RearrangeAsync(const QVector<VLayoutPaper> &previous,
+                                      const QVector<VLayoutDetail> &previousDetails)
+{
+    StartJob([this, previous, previousDetails](){RearrangeLayout(previous, previousDetails);});
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutGenerator::IsRunning() const
+{
+    return running.load() != 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Wait block until asynchronous job ends. Signals of job still wait in queue of event loop.
+ */
+void VLayoutGenerator::Wait()
+{
+    jobPool->waitForDone();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutGenerator::StartJob(const std::function<void()> &job)
+{
+    Wait();// Only one job at a time
+    // Reset in calling thread, otherwise Abort() before start of job will be lost.
+    stopGeneration.store(0);
+    running.store(1);
+    jobPool->start(new VLayoutJob([this, job]()
+    {
+        try
+        {
+            job();
+        }
+        catch (...)
+        {
+            // Exception can't leave thread of pool, and waiting side needs Done() anyway.
+            stopGeneration.store(1);
+            state = LayoutErrors::TerminatedByException;
+            emit Error(state);
+        }
+        running.store(0);
+        emit Done();
+    }));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief KeepAlive process events of GUI while synchronous generation waits for workers. Asynchronous job doesn't need
+ * it, its thread has no events and GUI thread runs own event loop.
+ */
+void VLayoutGenerator::KeepAlive() const
+{
+    if (QThread::currentThread() == thread())
+    {
+        QCoreApplication::processEvents();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RearrangeLayout update previous layout after changing of several details.
+ *
+ * Changed details are put on their old places if they still fit there. Other changed details are removed from
+ * sheets and arranged again against the rest of global contour. If a detail doesn't fit any more, or details were
+ * added or removed, or settings of paper changed, we do full generation. If nothing changed, user wants new layout,
+ * so we do full generation too.
+ * @param previous papers of previous layout. See GetPapers().
+ * @param previousDetails details of previous layout. Details are identified by number in the list.
+ */
+void VLayoutGenerator::RearrangeLayout(const QVector<VLayoutPaper> &previous,
+                                       const QVector<VLayoutDetail> &previousDetails)
+{
+    const QVector<VLayoutDetail> details = bank->GetDetails();
+    if (previous.isEmpty() || previousDetails.size() != details.size())
+    {
+        GenerateLayout();
+        return;
+    }
+
+    QVector<int> changed;
+    for (int i = 0; i < details.size(); ++i)
+    {
+        if (details.at(i).IsSameShape(previousDetails.at(i)) == false)
+        {
+            changed.append(i);
+        }
+    }
+
+    if (changed.isEmpty())
+    {
+        GenerateLayout();
+        return;
+    }
+
+    const VLayoutPaper settings = CreatePaper();
+    for (int i = 0; i < previous.size(); ++i)
+    {
+        if (previous.at(i).IsCompatible(settings) == false)
+        {
+            GenerateLayout();
+            return;
+        }
+    }
+
+    papers.clear();
+    statistics = VLayoutStatistics();
+    state = LayoutErrors::NoError;
+
+    emit Start();
+
+    if (bank->Prepare() == false)
+    {
+        state = LayoutErrors::PrepareLayoutError;
+        emit Error(state);
+        return;
+    }
+
+    CheckDetailsSize();
+    if (stopGeneration.load() != 0)
+    {
+        return;
+    }
+
+    QVector<VLayoutPaper> result = previous;
+    if (RearrangeChanged(result, changed) == false)
+    {
+        if (stopGeneration.load() == 0)
+        {
+            GenerateLayout();// Fall back to full layout
+        }
+        else
+        {
+            state = LayoutErrors::ProcessStoped;
+            emit Finished();
+        }
+        return;
+    }
+
+    papers = result;
+    emit Arranged(bank->AllDetailsCount());
+    emit Finished();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutGenerator::RearrangeChanged(QVector<VLayoutPaper> &papers, const QVector<int> &changed)
+{
+    const QVector<VLayoutDetail> details = bank->GetDetails();// Prepared details
+
+    QVector<int> homeless;
+    for (int i = 0; i < changed.size(); ++i)
+    {
+        const int id = changed.at(i);
+        int p = 0;
+        while (p < papers.size() && papers.at(p).ContainsDetail(id) == false)
+        {
+            ++p;
+        }
+
+        if (p == papers.size())
+        {
+            return false;// Previous layout doesn't know this detail
+        }
+
+        if (papers[p].ReplaceDetail(id, details.at(id)) == false)
+        {
+            papers[p].RemoveDetail(id);
+            homeless.append(id);
+        }
+    }
+
+    for (int i = 0; i < homeless.size(); ++i)
+    {
+        const int id = homeless.at(i);
+        bool arranged = false;
+        for (int p = 0; p < papers.size() && arranged == false; ++p)
+        {
+            if (papers[p].ArrangeDetail(details.at(id), stopGeneration, id))
+            {
+                // Global contour still has old versions of replaced details.
+                if (papers.at(p).HasOverlaps(id))
                 {
-                    bank->Arranged(index);
-                    emit Arranged(bank->ArrangedCount());
+                    papers[p].RemoveDetail(id);
                 }
                 else
                 {
-                    bank->NotArranged(index);
+                    arranged = true;
                 }
+            }
+
+            if (stopGeneration.load() != 0)
+            {
+                return false;
+            }
+        }
+
+        if (arranged == false)
+        {
+            return false;
+        }
+    }
+
+    for (int p = 0; p < papers.size(); ++p)
+    {
+        statistics += papers.at(p).GetStatistics();
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CreateVariants prepare layout runs.
+ *
+ * First variant always uses settings of user. In parallel mode we also try other principles of choosing the next
+ * workpiece, smaller shift and smaller rotation increase. Count of variants is limited by count of cores.
+ */
+QVector<VLayoutVariant *> VLayoutGenerator::CreateVariants() const
+{
+    QVector<Cases> cases;
+    cases.append(bank->GetCaseType());
+    const Cases allCases[] = {Cases::CaseThreeGroup, Cases::CaseTwoGroup, Cases::CaseDesc};
+    for (int i = 0; i < 3; ++i)
+    {
+        if (cases.contains(allCases[i]) == false)
+        {
+            cases.append(allCases[i]);
+        }
+    }
+
+    QVector<unsigned int> shifts;
+    shifts.append(shift);
+    if (shift/2 > 0 && placement == Placement::CombineEdges)// No-fit polygons don't use shift
+    {
+        shifts.append(shift/2);
+    }
+
+    QVector<int> increases;
+    increases.append(rotationIncrease);
+    if (rotate && rotationIncrease % 2 == 0 && 360 % (rotationIncrease/2) == 0)
+    {
+        increases.append(rotationIncrease/2);
+    }
+
+    int count = 1;
+    int threads = QThread::idealThreadCount();
+    if (parallelVariants)
+    {
+        count = qMax(1, qMin(threads, cases.size()*shifts.size()*increases.size()));
+    }
+    threads = qMax(1, threads/count);
 
-                if (stopGeneration)
+    const QVector<VLayoutDetail> details = bank->GetDetails();
+    QVector<VLayoutVariant *> variants;
+    for (int k = 0; k < increases.size(); ++k)
+    {
+        for (int j = 0; j < shifts.size(); ++j)
+        {
+            for (int i = 0; i < cases.size(); ++i)
+            {
+                if (variants.size() >= count)
                 {
-                    break;
+                    return variants;
                 }
-            } while(bank->LeftArrange() > 0);
 
-            if (stopGeneration)
-            {
-                break;
+                VLayoutVariant *variant = CreateVariant(details);
+                variant->SetCaseType(cases.at(i));
+                variant->SetShift(shifts.at(j));
+                variant->SetRotationIncrease(increases.at(k));
+                variant->SetThreadsCount(threads);
+                variants.append(variant);
             }
+        }
+    }
+    return variants;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CreateVariant create layout run with settings of generator and one thread.
+ */
+VLayoutVariant *VLayoutGenerator::CreateVariant(const QVector<VLayoutDetail> &details) const
+{
+    VLayoutVariant *variant = new VLayoutVariant(details, stopGeneration);
+    variant->SetLayoutWidth(bank->GetLayoutWidth());
+    variant->SetCaseType(bank->GetCaseType());
+    variant->SetPaperHeight(paperHeight);
+    variant->SetPaperWidth(paperWidth);
+    variant->SetRoll(roll);
+    variant->SetPlacement(placement);
+    variant->SetShift(shift);
+    variant->SetRotate(rotate);
+    variant->SetRotationIncrease(rotationIncrease);
+    variant->SetThreadsCount(1);
+    variant->SetSeed(seed);
+    variant->setAutoDelete(false);
+    return variant;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CreatePaper create empty paper with settings of generator.
+ */
+VLayoutPaper VLayoutGenerator::CreatePaper() const
+{
+    VLayoutPaper paper(paperHeight, paperWidth);
+    paper.SetRoll(roll);
+    paper.SetPlacement(placement);
+    paper.SetShift(shift);
+    paper.SetLayoutWidth(bank->GetLayoutWidth());
+    paper.SetRotate(rotate);
+    paper.SetRotationIncrease(rotationIncrease);
+    return paper;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RunVariants run all variants at the same time and keep the best result.
+ */
+void VLayoutGenerator::RunVariants(const QVector<VLayoutVariant *> &variants)
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, variants.size()));
+    for (int i = 0; i < variants.size(); ++i)
+    {
+        pool.start(variants.at(i));
+    }
+
+    // Keep GUI alive and report progress of the most successful variant.
+    int arranged = 0;
+    while (pool.waitForDone(50) == false)
+    {
+        KeepAlive();
 
-            if (paper.Count() > 0)
+        for (int i = 0; i < variants.size(); ++i)
+        {
+            if (variants.at(i)->ArrangedCount() > arranged)
             {
-                papers.append(paper);
+                arranged = variants.at(i)->ArrangedCount();
+                emit Arranged(arranged);
             }
-            else
+        }
+    }
+
+    for (int i = 0; i < variants.size(); ++i)
+    {
+        statistics += variants.at(i)->GetStatistics();
+    }
+
+    if (stopGeneration.load() != 0)
+    {
+        // Partial result. Keep sheets of the variant that arranged more details.
+        const VLayoutVariant *partial = variants.first();
+        for (int i = 1; i < variants.size(); ++i)
+        {
+            if (variants.at(i)->ArrangedCount() > partial->ArrangedCount())
             {
-                state = LayoutErrors::EmptyPaperError;
-                emit Error(state);
-                return;
+                partial = variants.at(i);
             }
         }
+        papers = partial->GetPapers();
+        return;
     }
-    else
+
+    const VLayoutVariant *best = variants.first();
+    for (int i = 1; i < variants.size(); ++i)
     {
-        state = LayoutErrors::PrepareLayoutError;
+        if (variants.at(i)->IsBetterThan(*best))
+        {
+            best = variants.at(i);
+        }
+    }
+
+    if (best->State() != LayoutErrors::NoError)
+    {
+        state = best->State();
         emit Error(state);
         return;
     }
-    emit Finished();
+
+    papers = best->GetPapers();
+    emit Arranged(bank->AllDetailsCount());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Optimize search better order and start rotation of details by simulated annealing.
+ *
+ * Each step we evaluate one neighbour solution per core by greedy layout and give the best of them to optimizer.
+ * Search works until time budget is over. Result of greedy layout is replaced only by really better solution.
+ */
+void VLayoutGenerator::Optimize()
+{
+    const QVector<VLayoutDetail> details = bank->GetDetails();
+
+    // Start from descending area, the most successful principle for greedy layout.
+    QVector<int> order(details.size());
+    for (int i = 0; i < details.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&details](int i, int j)
+    {
+        return details.at(i).Square() > details.at(j).Square();
+    });
+
+    QVector<int> angles;
+    if (rotate)
+    {
+        for (int angle = 0; angle < 360; angle += rotationIncrease)
+        {
+            angles.append(angle);
+        }
+    }
+
+    VLayoutOptimizer optimizer(order, angles,
+                               seed != 0 ? seed : static_cast<quint32>(QDateTime::currentMSecsSinceEpoch()));
+    qreal bestCost = VLayoutOptimizer::Cost(papers, paperHeight, roll);
+
+    const int threads = qMax(1, QThread::idealThreadCount());
+    const qint64 budget = static_cast<qint64>(optimizationTime)*1000;
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < budget && stopGeneration.load() == 0)
+    {
+        QVector<VLayoutVariant *> batch;
+        QVector<QVector<int> > orders;
+        QVector<QVector<int> > rotations;
+        for (int t = 0; t < threads; ++t)
+        {
+            QVector<int> candidateOrder;
+            QVector<int> candidateAngles;
+            optimizer.Neighbour(candidateOrder, candidateAngles);
+
+            QVector<VLayoutDetail> rotated = details;
+            for (int i = 0; i < rotated.size(); ++i)
+            {
+                if (candidateAngles.at(i) != 0)
+                {
+                    rotated[i].Rotate(rotated.at(i).BoundingRect().center(), candidateAngles.at(i));
+                }
+            }
+
+            VLayoutVariant *variant = CreateVariant(rotated);
+            variant->SetOrder(candidateOrder);
+            batch.append(variant);
+            orders.append(candidateOrder);
+            rotations.append(candidateAngles);
+            pool.start(variant);
+        }
+
+        while (pool.waitForDone(50) == false)
+        {
+            KeepAlive();
+            emit Optimizing(static_cast<int>(qMin(timer.elapsed(), budget)*100/budget));
+        }
+
+        int best = -1;
+        qreal batchCost = 0;
+        for (int i = 0; i < batch.size(); ++i)
+        {
+            statistics += batch.at(i)->GetStatistics();
+            if (batch.at(i)->State() != LayoutErrors::NoError)
+            {
+                continue;
+            }
+
+            const qreal cost = VLayoutOptimizer::Cost(batch.at(i)->GetPapers(), paperHeight, roll);
+            if (best < 0 || cost < batchCost)
+            {
+                best = i;
+                batchCost = cost;
+            }
+        }
+
+        if (best >= 0 && stopGeneration.load() == 0)
+        {
+            const qreal progress = static_cast<qreal>(timer.elapsed())/budget;
+            optimizer.Candidate(orders.at(best), rotations.at(best), batchCost, progress);
+            if (batchCost < bestCost)
+            {
+                bestCost = batchCost;
+                papers = batch.at(best)->GetPapers();
+            }
+        }
+
+        qDeleteAll(batch.begin(), batch.end());
+    }
+
+    emit Optimizing(100);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -154,6 +732,63 @@ LayoutErrors VLayoutGenerator::State() const
     return state;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPaper> VLayoutGenerator::GetPapers() const
+{
+    return papers;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutGenerator::PapersCount() const
+{
+    return papers.count();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Utilisation how much fabric used by details.
+ * @return percent of sum of details squares to squares of all sheets. For roll we use length of marker.
+ */
+qreal VLayoutGenerator::Utilisation() const
+{
+    const qreal length = roll ? MarkerLength() : static_cast<qreal>(paperHeight)*papers.count();
+    if (papers.isEmpty() || length <= 0 || paperWidth <= 0)
+    {
+        return 0;
+    }
+
+    qint64 square = 0;
+    for (int i=0; i < papers.count(); ++i)
+    {
+        square += papers.at(i).DetailsSquare();
+    }
+
+    return static_cast<qreal>(square)/(length*paperWidth)*100.0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MarkerLength total used length of all papers. Useful for roll, where we have only one paper.
+ */
+int VLayoutGenerator::MarkerLength() const
+{
+    int length = 0;
+    for (int i=0; i < papers.count(); ++i)
+    {
+        length += papers.at(i).MarkerLength();
+    }
+    return length;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetStatistics counters of checked positions of all variants of the last generation.
+ */
+VLayoutStatistics VLayoutGenerator::GetStatistics() const
+{
+    return statistics;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QList<QGraphicsItem *> VLayoutGenerator::GetPapersItems() const
 {
@@ -179,8 +814,11 @@ QList<QList<QGraphicsItem *> > VLayoutGenerator::GetAllDetails() const
 //---------------------------------------------------------------------------------------------------------------------
 void VLayoutGenerator::Abort()
 {
-    stopGeneration = true;
-    state = LayoutErrors::ProcessStoped;
+    stopGeneration.store(1);
+    if (IsRunning() == false)
+    {
+        state = LayoutErrors::ProcessStoped;
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -200,6 +838,204 @@ void VLayoutGenerator::SetRotationIncrease(int value)
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutGenerator::GetOptimizationTime() const
+{
+    return optimizationTime;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetOptimizationTime after greedy layout spend this time on searching better order of details.
+ * @param seconds time budget. 0 disables optimization.
+ */
+void VLayoutGenerator::SetOptimizationTime(int seconds)
+{
+    optimizationTime = qMax(0, seconds);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint32 VLayoutGenerator::GetSeed() const
+{
+    return seed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetSeed make layout reproducible. With the same seed, details and settings generator gives the same layout.
+ * Optimization is limited by time, so it repeats only the same sequence of solutions.
+ * @param seed 0 - details of one group go in given order, optimization takes seed from current time.
+ */
+void VLayoutGenerator::SetSeed(quint32 seed)
+{
+    this->seed = seed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief WriteResult save current layout to file. File keeps settings of paper and for each sheet the list of
+ * details with number, hash of shape, matrix and mirror flag. Geometry of details isn't saved.
+ * @return false if there is no layout or file can't be written.
+ */
+bool VLayoutGenerator::WriteResult(const QString &fileName) const
+{
+    if (state != LayoutErrors::NoError || papers.isEmpty())
+    {
+        return false;
+    }
+
+    QJsonArray sheets;
+    for (int i = 0; i < papers.size(); ++i)
+    {
+        const QVector<VLayoutDetail> details = papers.at(i).GetLayoutDetails();
+        const QVector<int> ids = papers.at(i).GetDetailIds();
+
+        QJsonArray sheet;
+        for (int j = 0; j < details.size(); ++j)
+        {
+            const QTransform m = details.at(j).GetMatrix();
+            QJsonArray matrix;
+            matrix.append(m.m11());
+            matrix.append(m.m12());
+            matrix.append(m.m13());
+            matrix.append(m.m21());
+            matrix.append(m.m22());
+            matrix.append(m.m23());
+            matrix.append(m.m31());
+            matrix.append(m.m32());
+            matrix.append(m.m33());
+
+            QJsonObject detail;
+            detail.insert(QStringLiteral("id"), ids.at(j));
+            detail.insert(QStringLiteral("hash"), ShapeHash(details.at(j)));
+            detail.insert(QStringLiteral("matrix"), matrix);
+            detail.insert(QStringLiteral("mirror"), details.at(j).IsMirror());
+            sheet.append(detail);
+        }
+        sheets.append(sheet);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("version"), layoutResultVersion);
+    root.insert(QStringLiteral("details"), bank->GetDetails().size());
+    root.insert(QStringLiteral("paperWidth"), paperWidth);
+    root.insert(QStringLiteral("paperHeight"), paperHeight);
+    root.insert(QStringLiteral("roll"), roll);
+    root.insert(QStringLiteral("layoutWidth"), bank->GetLayoutWidth());
+    root.insert(QStringLiteral("sheets"), sheets);
+
+    QFile file(fileName);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+    {
+        return false;
+    }
+
+    return file.write(QJsonDocument(root).toJson()) != -1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ReadResult restore layout saved by WriteResult() without searching positions. Details and settings of paper
+ * must be set before and must be the same as when the layout was saved.
+ * @return false if file is broken or doesn't match shapes of details and settings. Current layout stays untouched.
+ */
+bool VLayoutGenerator::ReadResult(const QString &fileName)
+{
+    QFile file(fileName);
+    if (file.open(QIODevice::ReadOnly) == false)
+    {
+        return false;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value(QStringLiteral("version")).toInt() != layoutResultVersion)
+    {
+        return false;
+    }
+
+    if (bank->Prepare() == false)
+    {
+        return false;
+    }
+
+    const QVector<VLayoutDetail> details = bank->GetDetails();
+    if (root.value(QStringLiteral("details")).toInt() != details.size() ||
+        root.value(QStringLiteral("paperWidth")).toInt() != paperWidth ||
+        root.value(QStringLiteral("paperHeight")).toInt() != paperHeight ||
+        root.value(QStringLiteral("roll")).toBool() != roll ||
+        qFuzzyCompare(root.value(QStringLiteral("layoutWidth")).toDouble(), bank->GetLayoutWidth()) == false)
+    {
+        return false;
+    }
+
+    QVector<VLayoutPaper> result;
+    QVector<bool> placed(details.size(), false);
+    const QJsonArray sheets = root.value(QStringLiteral("sheets")).toArray();
+    for (int i = 0; i < sheets.size(); ++i)
+    {
+        VLayoutPaper paper = CreatePaper();
+        paper.SetPaperIndex(static_cast<quint32>(i));
+
+        const QJsonArray sheet = sheets.at(i).toArray();
+        for (int j = 0; j < sheet.size(); ++j)
+        {
+            const QJsonObject detail = sheet.at(j).toObject();
+            const int id = detail.value(QStringLiteral("id")).toInt(-1);
+            const QJsonArray m = detail.value(QStringLiteral("matrix")).toArray();
+            if (id < 0 || id >= details.size() || placed.at(id) || m.size() != 9)
+            {
+                return false;
+            }
+
+            // Pattern could change while count of details stays the same.
+            if (detail.value(QStringLiteral("hash")).toString() != ShapeHash(details.at(id)))
+            {
+                return false;
+            }
+
+            const QTransform matrix(m.at(0).toDouble(), m.at(1).toDouble(), m.at(2).toDouble(),
+                                    m.at(3).toDouble(), m.at(4).toDouble(), m.at(5).toDouble(),
+                                    m.at(6).toDouble(), m.at(7).toDouble(), m.at(8).toDouble());
+            const bool mirror = detail.value(QStringLiteral("mirror")).toBool();
+            if (paper.PlaceDetail(id, details.at(id), matrix, mirror) == false)
+            {
+                return false;
+            }
+            placed[id] = true;
+        }
+
+        if (paper.Count() > 0)
+        {
+            result.append(paper);
+        }
+    }
+
+    if (placed.contains(false))
+    {
+        return false;
+    }
+
+    papers = result;
+    statistics = VLayoutStatistics();
+    state = LayoutErrors::NoError;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutGenerator::GetParallelVariants() const
+{
+    return parallelVariants;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetParallelVariants enable mode when several greedy layouts with different settings run at the same time.
+ */
+void VLayoutGenerator::SetParallelVariants(bool value)
+{
+    parallelVariants = value;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VLayoutGenerator::GetRotate() const
 {
@@ -216,11 +1052,11 @@ void VLayoutGenerator::SetRotate(bool value)
 void VLayoutGenerator::CheckDetailsSize()
 {
     const QRectF rec = bank->GetBiggestBoundingRect();
-    if (rec.width() > paperWidth || rec.height() > paperHeight)
+    if (rec.width() > paperWidth || (roll == false && rec.height() > paperHeight))
     {
         state = LayoutErrors::PaperSizeError;
         emit Error(state);
-        stopGeneration = true;
+        stopGeneration.store(1);
     }
 }
 
@@ -236,6 +1072,37 @@ void VLayoutGenerator::SetPaperWidth(int value)
     paperWidth = value;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutGenerator::IsRoll() const
+{
+    return roll;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetRoll strip packing on fabric roll. All details are arranged on one paper with fixed width, height of
+ * paper is ignored and we try to get the shortest marker.
+ */
+void VLayoutGenerator::SetRoll(bool value)
+{
+    roll = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+Placement VLayoutGenerator::GetPlacement() const
+{
+    return placement;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetPlacement choose engine for searching position of details.
+ */
+void VLayoutGenerator::SetPlacement(Placement value)
+{
+    placement = value;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 unsigned int VLayoutGenerator::GetShift() const
 {
@@ -31,13 +31,20 @@
 
 #include <QObject>
 #include <QList>
+#include <QAtomicInt>
+#include <QMetaType>
 
 #include "vlayoutdef.h"
 #include "vbank.h"
+#include "vlayoutstatistics.h"
+
+#include <functional>
 
 class VLayoutPaper;
 class VLayoutDetail;
 class QGraphicsItem;
+class VLayoutVariant;
+class QThreadPool;
 
 class VLayoutGenerator :public QObject
 {
@@ -57,13 +64,32 @@ public:
     int GetPaperWidth() const;
     void SetPaperWidth(int value);
 
+    bool IsRoll() const;
+    void SetRoll(bool value);
+
+    Placement GetPlacement() const;
+    void      SetPlacement(Placement value);
+
     unsigned int GetShift() const;
     void         SetShift(unsigned int shift);
 
     void Generate();
+    void Rearrange(const QVector<VLayoutPaper> &previous, const QVector<VLayoutDetail> &previousDetails);
+
+    void GenerateAsync();
+    void RearrangeAsync(const QVector<VLayoutPaper> &previous, const QVector<VLayoutDetail> &previousDetails);
+    bool IsRunning() const;
+    void Wait();
 
     LayoutErrors State() const;
 
+    QVector<VLayoutPaper> GetPapers() const;
+
+    int               PapersCount() const;
+    qreal             Utilisation() const;
+    int               MarkerLength() const;
+    VLayoutStatistics GetStatistics() const;
+
     QList<QGraphicsItem *> GetPapersItems() const;
     QList<QList<QGraphicsItem *>> GetAllDetails() const;
 
@@ -73,11 +99,25 @@ public:
     int GetRotationIncrease() const;
     void SetRotationIncrease(int value);
 
+    bool GetParallelVariants() const;
+    void SetParallelVariants(bool value);
+
+    int  GetOptimizationTime() const;
+    void SetOptimizationTime(int seconds);
+
+    quint32 GetSeed() const;
+    void    SetSeed(quint32 seed);
+
+    bool WriteResult(const QString &fileName) const;
+    bool ReadResult(const QString &fileName);
+
 signals:
     void Start();
     void Arranged(int count);
+    void Optimizing(int percent);
     void Error(const LayoutErrors &state);
     void Finished();
+    void Done();
 
 public slots:
     void Abort();
@@ -85,16 +125,44 @@ public slots:
 private:
     Q_DISABLE_COPY(VLayoutGenerator)
     QVector<VLayoutPaper> papers;
+    VLayoutStatistics statistics;
     VBank *bank;
     int paperHeight;
     int paperWidth;
-    bool stopGeneration;
+    bool roll;
+    Placement placement;
+    QAtomicInt stopGeneration;
     LayoutErrors state;
     unsigned int shift;
     bool rotate;
     int rotationIncrease;
+    bool parallelVariants;
+
+    /** @brief optimizationTime time budget in seconds for searching better order of details. 0 - don't search. */
+    int optimizationTime;
+
+    /** @brief jobPool one thread for asynchronous job. */
+    QThreadPool *jobPool;
 
+    /** @brief running 1 while asynchronous job works. */
+    QAtomicInt running;
+
+    /** @brief seed makes layout reproducible. 0 - details go in given order, optimization uses current time. */
+    quint32 seed;
+
+    void GenerateLayout();
+    void RearrangeLayout(const QVector<VLayoutPaper> &previous, const QVector<VLayoutDetail> &previousDetails);
     void CheckDetailsSize();
+    QVector<VLayoutVariant *> CreateVariants() const;
+    void RunVariants(const QVector<VLayoutVariant *> &variants);
+    void Optimize();
+    VLayoutVariant *CreateVariant(const QVector<VLayoutDetail> &details) const;
+    bool RearrangeChanged(QVector<VLayoutPaper> &papers, const QVector<int> &changed);
+    VLayoutPaper CreatePaper() const;
+    void KeepAlive() const;
+    void StartJob(const std::function<void()> &job);
 };
 
+Q_DECLARE_METATYPE(LayoutErrors)
+
 #endif // VLAYOUTGENERATOR_H
@@ -0,0 +1,188 @@
+/************************************************************************
+ **
+ **  @file   vlayoutoptimizer.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+
+#include "vlayoutoptimizer.h"
+#include "vlayoutpaper.h"
+
+#include <QtMath>
+
+namespace
+{
+// Start temperature as part of cost of the first solution. Worse solution on 2% will be accepted with probability
+// 1/e at the beginning.
+const qreal temperatureFactor = 0.02;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VLayoutOptimizer constructor.
+ * @param order start order of details. Contains numbers of details in bank.
+ * @param allowedAngles angles for start rotation. If empty details will not be rotated.
+ * @param seed seed of random generator. The same seed gives the same sequence of solutions.
+ */
+VLayoutOptimizer::VLayoutOptimizer(const QVector<int> &order, const QVector<int> &allowedAngles, quint32 seed)
+    :allowedAngles(allowedAngles), order(order), angles(QVector<int>(order.size(), 0)), cost(0), bestCost(0),
+      startTemperature(0), hasCost(false), startProposed(false), generator(seed)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Neighbour propose new solution close to current. The first proposal is the start solution itself.
+ */
+void VLayoutOptimizer::Neighbour(QVector<int> &order, QVector<int> &angles)
+{
+    order = this->order;
+    angles = this->angles;
+
+    if (startProposed == false)
+    {
+        startProposed = true;
+        return;
+    }
+
+    const int n = order.size();
+    if (n == 0 || (n < 2 && allowedAngles.size() < 2))
+    {
+        return;
+    }
+
+    const int moves = allowedAngles.size() > 1 ? 3 : 2;
+    switch (n < 2 ? 2 : Random(moves))
+    {
+        case 0:// Swap two details
+        {
+            const int i = Random(n);
+            const int j = Random(n);
+            qSwap(order[i], order[j]);
+            break;
+        }
+        case 1:// Move detail to other place
+        {
+            const int from = Random(n);
+            const int to = Random(n);
+            order.move(from, to);
+            break;
+        }
+        case 2:// Change start rotation of detail
+        {
+            const int i = order.at(Random(n));
+            angles[i] = allowedAngles.at(Random(allowedAngles.size()));
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidate decide whether to move to evaluated solution.
+ * @param order order of details of solution.
+ * @param angles start rotation of details of solution.
+ * @param cost cost of solution. See Cost().
+ * @param progress spent part of time budget from 0 to 1. Temperature goes down linearly with time.
+ * @return true if solution is the best from the beginning.
+ */
+bool VLayoutOptimizer::Candidate(const QVector<int> &order, const QVector<int> &angles, qreal cost, qreal progress)
+{
+    if (hasCost == false)
+    {
+        hasCost = true;
+        this->order = order;
+        this->angles = angles;
+        this->cost = cost;
+        bestCost = cost;
+        startTemperature = cost*temperatureFactor;
+        return true;
+    }
+
+    const qreal delta = cost - this->cost;
+    const qreal temperature = startTemperature*qMax(0.0, 1.0 - progress);
+    bool accept = delta <= 0;
+    if (accept == false && temperature > 0)
+    {
+        std::uniform_real_distribution<qreal> distribution(0, 1);
+        accept = distribution(generator) < qExp(-delta/temperature);
+    }
+
+    if (accept)
+    {
+        this->order = order;
+        this->angles = angles;
+        this->cost = cost;
+    }
+
+    if (cost < bestCost)
+    {
+        bestCost = cost;
+        return true;
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutOptimizer::HasCost() const
+{
+    return hasCost;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal VLayoutOptimizer::BestCost() const
+{
+    return bestCost;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Cost used length of fabric. All sheets except the last are used completely.
+ */
+qreal VLayoutOptimizer::Cost(const QVector<VLayoutPaper> &papers, int paperHeight, bool roll)
+{
+    if (papers.isEmpty())
+    {
+        return 0;
+    }
+
+    if (roll)
+    {
+        qreal length = 0;
+        for (int i = 0; i < papers.size(); ++i)
+        {
+            length += papers.at(i).MarkerLength();
+        }
+        return length;
+    }
+
+    return static_cast<qreal>(paperHeight)*(papers.size()-1) + papers.last().MarkerLength();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutOptimizer::Random(int max)
+{
+    std::uniform_int_distribution<int> distribution(0, max-1);
+    return distribution(generator);
+}
@@ -0,0 +1,78 @@
+/************************************************************************
+ **
+ **  @file   vlayoutoptimizer.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+
+#ifndef VLAYOUTOPTIMIZER_H
+#define VLAYOUTOPTIMIZER_H
+
+#include <QVector>
+#include <random>
+
+class VLayoutPaper;
+
+/**
+ * @brief The VLayoutOptimizer class simulated annealing over order of details and their start rotation.
+ *
+ * Optimizer doesn't arrange details itself. It only proposes new solutions (order + angles) and decides which of
+ * evaluated solutions to keep. Greedy layout is used as fitness function, so it's up to caller how and where run it.
+ */
+class VLayoutOptimizer
+{
+public:
+    VLayoutOptimizer(const QVector<int> &order, const QVector<int> &allowedAngles, quint32 seed);
+
+    void Neighbour(QVector<int> &order, QVector<int> &angles);
+    bool Candidate(const QVector<int> &order, const QVector<int> &angles, qreal cost, qreal progress);
+
+    bool  HasCost() const;
+    qreal BestCost() const;
+
+    static qreal Cost(const QVector<VLayoutPaper> &papers, int paperHeight, bool roll);
+
+private:
+    Q_DISABLE_COPY(VLayoutOptimizer)
+
+    /** @brief allowedAngles angles that we can use for start rotation of detail. */
+    QVector<int> allowedAngles;
+
+    /** @brief order current order of details in bank. */
+    QVector<int> order;
+
+    /** @brief angles current start rotation of each detail. Index is number of detail in bank. */
+    QVector<int> angles;
+
+    qreal cost;
+    qreal bestCost;
+    qreal startTemperature;
+    bool  hasCost;
+    bool  startProposed;
+
+    std::mt19937 generator;
+
+    int Random(int max);
+};
+
+#endif // VLAYOUTOPTIMIZER_H
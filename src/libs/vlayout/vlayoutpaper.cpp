@@ -30,11 +30,63 @@
 #include "vlayoutpaper_p.h"
 #include "vbestsquare.h"
 #include "vposition.h"
+#include "vspatialindex.h"
+#include "vnofitpolygon.h"
 
 #include <QGraphicsItem>
-#include <QCoreApplication>
 #include <QThreadPool>
 #include <QPen>
+#include <QPainterPath>
+#include <QtMath>
+#include <algorithm>
+
+namespace
+{
+// Details touch each other by edges. Overlapping less than this square in pixels is a rounding error.
+const qreal overlapTolerance = 1.0;
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal PolygonSquare(const QPolygonF &polygon)
+{
+    qreal square = 0;
+    for (int i = 0; i < polygon.size(); ++i)
+    {
+        const QPointF &p1 = polygon.at(i);
+        const QPointF &p2 = polygon.at((i+1) % polygon.size());
+        square += p1.x()*p2.y() - p2.x()*p1.y();
+    }
+    return qAbs(square)/2;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief OverlapSquare square of common part of layout allowence of detail and polygon.
+ */
+qreal OverlapSquare(const QVector<QPointF> &points, const VLayoutDetail &detail)
+{
+    const QPolygonF polygon(points);
+    if (polygon.boundingRect().intersects(detail.BoundingRect()) == false)
+    {
+        return 0;
+    }
+
+    QPainterPath path1;
+    path1.addPolygon(polygon);
+    path1.closeSubpath();
+
+    QPainterPath path2;
+    path2.addPolygon(QPolygonF(detail.GetLayoutAllowencePoints()));
+    path2.closeSubpath();
+
+    const QList<QPolygonF> common = path1.intersected(path2).toFillPolygons();
+    qreal square = 0;
+    for (int i = 0; i < common.size(); ++i)
+    {
+        square += PolygonSquare(common.at(i));
+    }
+    return square;
+}
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutPaper::VLayoutPaper()
@@ -90,6 +142,21 @@ void VLayoutPaper::SetWidth(int width)
     d->globalContour.SetWidth(width);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutPaper::IsRoll() const
+{
+    return d->globalContour.IsRoll();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetRoll use paper with fixed width and unlimited height (fabric roll). Height of paper will be ignored.
+ */
+void VLayoutPaper::SetRoll(bool value)
+{
+    d->globalContour.SetRoll(value);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 qreal VLayoutPaper::GetLayoutWidth() const
 {
@@ -153,10 +220,44 @@ void VLayoutPaper::SetPaperIndex(quint32 index)
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-bool VLayoutPaper::ArrangeDetail(const VLayoutDetail &detail, bool &stop)
+void VLayoutPaper::SetThreadPool(QThreadPool *pool)
+{
+    d->threadPool = pool;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+Placement VLayoutPaper::GetPlacement() const
+{
+    return d->placement;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutPaper::SetPlacement(Placement value)
+{
+    d->placement = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetNfpCache set cache of no-fit polygons. Cache must live longer than paper will arrange details.
+ */
+void VLayoutPaper::SetNfpCache(VNfpCache *cache)
+{
+    d->nfpCache = cache;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ArrangeDetail try to find place for detail on the sheet.
+ * @param detail detail with prepared layout allowence.
+ * @param stop flag of canceling generation.
+ * @param id number of detail in bank. Used only as a key for caching no-fit polygons.
+ * @return true if detail was arranged.
+ */
+bool VLayoutPaper::ArrangeDetail(const VLayoutDetail &detail, const QAtomicInt &stop, int id)
 {
     // First need set size of paper
-    if (d->globalContour.GetHeight() <= 0 || d->globalContour.GetWidth() <= 0)
+    if ((d->globalContour.IsRoll() == false && d->globalContour.GetHeight() <= 0) || d->globalContour.GetWidth() <= 0)
     {
         return false;
     }
@@ -168,70 +269,434 @@ bool VLayoutPaper::ArrangeDetail(const VLayoutDetail &detail, bool &stop)
 
     d->frame = 0;
 
-    return AddToSheet(detail, stop);
+    if (d->placement == Placement::NoFitPolygon)
+    {
+        return AddByNoFitPolygon(detail, stop, id);
+    }
+
+    return AddToSheet(detail, stop, id);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-int VLayoutPaper::Count() const
+bool VLayoutPaper::ContainsDetail(int id) const
 {
-    return d->details.count();
+    return id >= 0 && d->ids.contains(id);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-bool VLayoutPaper::AddToSheet(const VLayoutDetail &detail, bool &stop)
+/**
+ * @brief ReplaceDetail put changed detail on the place of old one.
+ *
+ * Detail gets the same transformation as old one. Replacing fails if new detail goes out of sheet or overlaps other
+ * details. Global contour isn't changed, so space of old detail stays reserved.
+ * @param id number of detail in bank.
+ * @param detail new version of detail with prepared layout allowence.
+ * @return true if detail was replaced.
+ */
+bool VLayoutPaper::ReplaceDetail(int id, const VLayoutDetail &detail)
 {
-    VBestSquare bestResult;
-    QThreadPool *thread_pool = QThreadPool::globalInstance();
-    QVector<VPosition *> threads;
+    const int index = d->ids.indexOf(id);
+    if (id < 0 || index == -1)
+    {
+        return false;
+    }
 
-    for (int j=1; j <= d->globalContour.EdgesCount(); ++j)
+    VLayoutDetail workDetail = detail;
+    workDetail.SetMatrix(d->details.at(index).GetMatrix());
+    workDetail.SetMirror(d->details.at(index).IsMirror());
+
+    if (d->globalContour.Contains(workDetail.BoundingRect()) == false)
     {
-        for (int i=1; i<= detail.EdgesCount(); i++)
+        return false;
+    }
+
+    const QVector<QPointF> points = workDetail.GetLayoutAllowencePoints();
+    for (int i=0; i < d->details.count(); ++i)
+    {
+        if (i != index && OverlapSquare(points, d->details.at(i)) > overlapTolerance)
         {
-            QCoreApplication::processEvents();
-
-            VPosition *thread = new VPosition(d->globalContour, j, detail, i, &stop, d->rotate, d->rotationIncrease);
-            //Info for debug
-            #ifdef LAYOUT_DEBUG
-                thread->setPaperIndex(d->paperIndex);
-                thread->setFrame(d->frame);
-                thread->setDetailsCount(d->details.count());
-                thread->setDetails(d->details);
-            #endif
-
-            thread->setAutoDelete(false);
-            threads.append(thread);
-            thread_pool->start(thread);
-
-            d->frame = d->frame + 3 + 360/d->rotationIncrease*2;
+            return false;
         }
     }
 
-    if (thread_pool->waitForDone() == false)
+    d->details[index] = workDetail;
+
+    for (int i=0; i < d->nfpItems.count(); ++i)
+    {
+        if (d->nfpItems.at(i).id == id)
+        {
+            VLayoutDetail rotated = detail;
+            rotated.SetMatrix(d->nfpItems.at(i).matrix);
+            d->nfpItems[i].hull = rotated.GetConvexHull();
+            break;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PlaceDetail put detail on known place without searching. Used for restoring saved layout. Global contour
+ * isn't changed.
+ * @return false if detail goes out of sheet.
+ */
+bool VLayoutPaper::PlaceDetail(int id, const VLayoutDetail &detail, const QTransform &matrix, bool mirror)
+{
+    VLayoutDetail workDetail = detail;
+    workDetail.SetMatrix(matrix);
+    workDetail.SetMirror(mirror);
+
+    if (d->globalContour.Contains(workDetail.BoundingRect()) == false)
     {
         return false;
     }
 
-    QCoreApplication::processEvents();
+    d->details.append(workDetail);
+    d->ids.append(id);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RemoveDetail remove detail from sheet. Global contour isn't changed, so space stays reserved.
+ */
+void VLayoutPaper::RemoveDetail(int id)
+{
+    const int index = d->ids.indexOf(id);
+    if (id < 0 || index == -1)
+    {
+        return;
+    }
+
+    d->details.remove(index);
+    d->ids.remove(index);
+
+    for (int i=0; i < d->nfpItems.count(); ++i)
+    {
+        if (d->nfpItems.at(i).id == id)
+        {
+            d->nfpItems.remove(i);
+            break;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsCompatible check if details arranged on the paper are still valid for settings of other paper. Shift and
+ * rotation increase change only the way of searching, so they don't matter.
+ */
+bool VLayoutPaper::IsCompatible(const VLayoutPaper &paper) const
+{
+    return GetWidth() == paper.GetWidth() && (IsRoll() || GetHeight() == paper.GetHeight()) &&
+           IsRoll() == paper.IsRoll() && qFuzzyCompare(GetLayoutWidth(), paper.GetLayoutWidth()) &&
+           GetRotate() == paper.GetRotate() && GetPlacement() == paper.GetPlacement();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief HasOverlaps check if detail overlaps other details on the sheet.
+ */
+bool VLayoutPaper::HasOverlaps(int id) const
+{
+    const int index = d->ids.indexOf(id);
+    if (id < 0 || index == -1)
+    {
+        return false;
+    }
+
+    const QVector<QPointF> points = d->details.at(index).GetLayoutAllowencePoints();
+    for (int i=0; i < d->details.count(); ++i)
+    {
+        if (i != index && OverlapSquare(points, d->details.at(i)) > overlapTolerance)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutPaper::Count() const
+{
+    return d->details.count();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Efficiency how dense details arranged on the sheet.
+ * @return percent of details square inside bounding rectangle of all arranged details.
+ */
+qreal VLayoutPaper::Efficiency() const
+{
+    QRectF rect;
+    for (int i=0; i < d->details.count(); ++i)
+    {
+        rect = rect.united(d->details.at(i).BoundingRect());
+    }
+
+    const qreal square = rect.width()*rect.height();
+    if (square <= 0)
+    {
+        return 0;
+    }
+    return static_cast<qreal>(DetailsSquare())/square*100.0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DetailsSquare sum of squares of all arranged details.
+ */
+qint64 VLayoutPaper::DetailsSquare() const
+{
+    qint64 square = 0;
+    for (int i=0; i < d->details.count(); ++i)
+    {
+        square += d->details.at(i).Square();
+    }
+    return square;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MarkerLength used length of paper. For roll this is length of marker.
+ */
+int VLayoutPaper::MarkerLength() const
+{
+    qreal length = 0;
+    for (int i=0; i < d->details.count(); ++i)
+    {
+        length = qMax(length, d->details.at(i).BoundingRect().bottom());
+    }
+    return qCeil(length);
+}
 
-    if (stop)
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutStatistics VLayoutPaper::GetStatistics() const
+{
+    return d->statistics;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutPaper::AddToSheet(const VLayoutDetail &detail, const QAtomicInt &stop, int id)
+{
+    VBestSquare bestResult;
+    QThreadPool *thread_pool = d->threadPool != nullptr ? d->threadPool : QThreadPool::globalInstance();
+    QVector<VPosition *> threads;
+
+    // Global contour doesn't change until we save result, so all threads can share one index.
+    const VSpatialIndex index(d->globalContour);
+
+    // Workers take candidates from common counter, so we need only one worker per thread.
+    QAtomicInt nextCandidate(0);
+    const int candidates = VPosition::CandidatesCount(index.EdgesCount(), detail.EdgesCount());
+    const int workers = qBound(1, (candidates + VPosition::ChunkSize - 1)/VPosition::ChunkSize,
+                               qMax(1, thread_pool->maxThreadCount()));
+
+    for (int w = 0; w < workers; ++w)
+    {
+        VPosition *thread = new VPosition(d->globalContour, index, detail, nextCandidate, stop, d->rotate,
+                                          d->rotationIncrease);
+        //Info for debug
+        #ifdef LAYOUT_DEBUG
+            thread->setPaperIndex(d->paperIndex);
+            thread->setFrame(d->frame);
+            thread->setDetailsCount(d->details.count());
+            thread->setDetails(d->details);
+        #endif
+
+        thread->setAutoDelete(false);
+        threads.append(thread);
+        thread_pool->start(thread);
+    }
+
+    d->frame = d->frame + static_cast<quint32>(candidates)*VPosition::FramesPerCandidate(d->rotationIncrease);
+
+    thread_pool->waitForDone();
+
+    for (int i=0; i < threads.size(); ++i)
     {
+        d->statistics += threads.at(i)->getStatistics();
+    }
+
+    if (stop.load() != 0)
+    {
+        qDeleteAll(threads.begin(), threads.end());
         return false;
     }
 
+    QMap<int, VBestSquare> chunkResults;
     for (int i=0; i < threads.size(); ++i)
     {
-        bestResult.NewResult(threads.at(i)->getBestResult());
+        chunkResults.unite(threads.at(i)->getChunkResults());// Chunks never repeat
+    }
+
+    QMap<int, VBestSquare>::const_iterator chunk = chunkResults.constBegin();
+    while (chunk != chunkResults.constEnd())
+    {
+        bestResult.NewResult(chunk.value());
+        ++chunk;
     }
 
     qDeleteAll(threads.begin(), threads.end());
     threads.clear();
 
-    return SaveResult(bestResult, detail);
+    return SaveResult(bestResult, detail, id);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-bool VLayoutPaper::SaveResult(const VBestSquare &bestResult, const VLayoutDetail &detail)
+/**
+ * @brief AddByNoFitPolygon arrange detail in the lowest position, then the most left, where its convex hull doesn't
+ * overlap hulls of arranged details.
+ *
+ * Instead of checking all combinations of edges we enumerate vertices and intersections of no-fit polygons and check
+ * them from the best. First position that is outside of all no-fit polygons is the answer for this rotation.
+ */
+bool VLayoutPaper::AddByNoFitPolygon(const VLayoutDetail &detail, const QAtomicInt &stop, int id)
+{
+    const int width = d->globalContour.GetWidth();
+    // Big enough for any marker, but doesn't lose precision of coordinates.
+    const qreal height = d->globalContour.IsRoll() ? 1e7 : d->globalContour.GetHeight();
+
+    int increase = 360;
+    if (d->rotate)
+    {
+        increase = d->rotationIncrease;
+    }
+
+    bool found = false;
+    qreal bestBottom = 0;
+    qreal bestLeft = 0;
+    VNfpItem best;
+    QTransform bestMatrix;
+    bool bestMirror = false;
+
+    // Each orientation starts from incoming matrix, so start rotation from optimizer is kept.
+    const QTransform start = detail.GetMatrix();
+    const int angles = (360 + increase - 1)/increase;
+    for (int orientation = 0; orientation < 2*angles; ++orientation)
+    {
+        if (stop.load() != 0)
+        {
+            return false;
+        }
+
+        // First all rotations, after that all rotations of mirrored detail, as edge-combine search tries both sides.
+        const int angle = (orientation % angles)*increase;
+        const bool mirror = orientation >= angles;
+        QTransform matrix = start;
+        if (mirror)
+        {
+            matrix *= QTransform::fromScale(1, -1);
+        }
+        matrix *= QTransform().rotate(angle);
+
+        VLayoutDetail workDetail = detail;
+        workDetail.SetMatrix(matrix);
+        workDetail.SetMirror(detail.IsMirror() != mirror);
+        const QRectF rect = workDetail.BoundingRect();
+
+        // Inner-fit rectangle. All translations that keep detail inside of sheet.
+        const QRectF innerFit(QPointF(-rect.left(), -rect.top()),
+                              QPointF(width - rect.right(), height - rect.bottom()));
+        if (innerFit.width() < 0 || innerFit.height() < 0)
+        {
+            continue;
+        }
+
+        VNfpItem moving;
+        moving.id = id;
+        moving.angle = angle;
+        moving.mirror = mirror;
+        moving.matrix = matrix;
+        moving.hull = workDetail.GetConvexHull();
+
+        QVector<QVector<QPointF> > polygons;
+        polygons.reserve(d->nfpItems.size());
+        for (int i = 0; i < d->nfpItems.size(); ++i)
+        {
+            const VNfpItem &fixed = d->nfpItems.at(i);
+            QVector<QPointF> nfp;
+            if (d->nfpCache != nullptr)
+            {
+                nfp = d->nfpCache->Polygon(fixed, moving);
+            }
+            else
+            {
+                nfp = VNoFitPolygon::Convex(fixed.hull, moving.hull);
+            }
+
+            for (int k = 0; k < nfp.size(); ++k)
+            {
+                nfp[k] += fixed.offset;
+            }
+            polygons.append(nfp);
+        }
+
+        QVector<QPointF> candidates = VNoFitPolygon::Candidates(polygons, innerFit);
+        std::sort(candidates.begin(), candidates.end(), [](const QPointF &p1, const QPointF &p2)
+        {
+            return p1.y() < p2.y() || (p1.y() <= p2.y() && p1.x() < p2.x());
+        });
+
+        for (int i = 0; i < candidates.size(); ++i)
+        {
+            const QPointF &offset = candidates.at(i);
+            const qreal bottom = offset.y() + rect.bottom();
+            if (found && bottom > bestBottom)
+            {
+                break;// Can't be better than result from other rotation
+            }
+
+            ++d->statistics.positions;
+            bool valid = true;
+            for (int k = 0; k < polygons.size(); ++k)
+            {
+                if (VNoFitPolygon::StrictlyContains(polygons.at(k), offset))
+                {
+                    valid = false;
+                    break;
+                }
+            }
+
+            if (valid == false)
+            {
+                ++d->statistics.intersections;
+                continue;
+            }
+
+            ++d->statistics.accepted;
+            const qreal left = offset.x() + rect.left();
+            if (found == false || bottom < bestBottom || (qFuzzyCompare(bottom, bestBottom) && left < bestLeft))
+            {
+                found = true;
+                bestBottom = bottom;
+                bestLeft = left;
+                best = moving;
+                best.offset = offset;
+                bestMatrix = matrix * QTransform::fromTranslate(offset.x(), offset.y());
+                bestMirror = workDetail.IsMirror();
+            }
+            break;
+        }
+    }
+
+    if (found == false)
+    {
+        return false;
+    }
+
+    VLayoutDetail workDetail = detail;
+    workDetail.SetMatrix(bestMatrix);
+    workDetail.SetMirror(bestMirror);
+    d->details.append(workDetail);
+    d->ids.append(id);
+    d->nfpItems.append(best);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutPaper::SaveResult(const VBestSquare &bestResult, const VLayoutDetail &detail, int id)
 {
     if (bestResult.ValideResult())
     {
@@ -246,6 +711,7 @@ bool VLayoutPaper::SaveResult(const VBestSquare &bestResult, const VLayoutDetail
             return false;
         }
         d->details.append(workDetail);
+        d->ids.append(id);
         d->globalContour.SetContour(newGContour);
 
 #ifdef LAYOUT_DEBUG
@@ -272,8 +738,12 @@ void VLayoutPaper::SaveCandidate(VBestSquare &bestResult, const VLayoutDetail &d
 //---------------------------------------------------------------------------------------------------------------------
 QGraphicsRectItem *VLayoutPaper::GetPaperItem() const
 {
-    QGraphicsRectItem *paper = new QGraphicsRectItem(QRectF(0, 0, d->globalContour.GetWidth(),
-                                                            d->globalContour.GetHeight()));
+    int height = d->globalContour.GetHeight();
+    if (d->globalContour.IsRoll())
+    {
+        height = MarkerLength();
+    }
+    QGraphicsRectItem *paper = new QGraphicsRectItem(QRectF(0, 0, d->globalContour.GetWidth(), height));
     paper->setPen(QPen(Qt::black, 1));
     paper->setBrush(QBrush(Qt::white));
     return paper;
@@ -289,3 +759,21 @@ QList<QGraphicsItem *> VLayoutPaper::GetDetails() const
     }
     return list;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetLayoutDetails return arranged details with their matrices.
+ */
+QVector<VLayoutDetail> VLayoutPaper::GetLayoutDetails() const
+{
+    return d->details;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetDetailIds return numbers of arranged details in the same order as GetLayoutDetails().
+ */
+QVector<int> VLayoutPaper::GetDetailIds() const
+{
+    return d->ids;
+}
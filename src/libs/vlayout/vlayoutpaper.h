@@ -30,6 +30,7 @@
 #define VLAYOUTPAPER_H
 
 #include <QSharedDataPointer>
+#include <QVector>
 #include "vlayoutdef.h"
 
 class VLayoutPaperData;
@@ -37,6 +38,11 @@ class VLayoutDetail;
 class QGraphicsItem;
 class VBestSquare;
 class QGraphicsRectItem;
+class QAtomicInt;
+class QThreadPool;
+class VLayoutStatistics;
+class VNfpCache;
+class QTransform;
 
 class VLayoutPaper
 {
@@ -53,6 +59,9 @@ public:
     int  GetWidth() const;
     void SetWidth(int width);
 
+    bool IsRoll() const;
+    void SetRoll(bool value);
+
     qreal GetLayoutWidth() const;
     void  SetLayoutWidth(qreal width);
 
@@ -67,17 +76,37 @@ public:
 
     void SetPaperIndex(quint32 index);
 
-    bool ArrangeDetail(const VLayoutDetail &detail, bool &stop);
+    void SetThreadPool(QThreadPool *pool);
+
+    Placement GetPlacement() const;
+    void      SetPlacement(Placement value);
+
+    void SetNfpCache(VNfpCache *cache);
+
+    bool ArrangeDetail(const VLayoutDetail &detail, const QAtomicInt &stop, int id = -1);
+    bool ContainsDetail(int id) const;
+    bool ReplaceDetail(int id, const VLayoutDetail &detail);
+    void RemoveDetail(int id);
+    bool IsCompatible(const VLayoutPaper &paper) const;
+    bool HasOverlaps(int id) const;
+    bool PlaceDetail(int id, const VLayoutDetail &detail, const QTransform &matrix, bool mirror);
     int  Count() const;
+    qreal Efficiency() const;
+    qint64 DetailsSquare() const;
+    int    MarkerLength() const;
+    VLayoutStatistics GetStatistics() const;
     QGraphicsRectItem *GetPaperItem() const;
     QList<QGraphicsItem *> GetDetails() const;
+    QVector<VLayoutDetail> GetLayoutDetails() const;
+    QVector<int>           GetDetailIds() const;
 
 private:
     QSharedDataPointer<VLayoutPaperData> d;
 
-    bool AddToSheet(const VLayoutDetail &detail, bool &stop);
+    bool AddToSheet(const VLayoutDetail &detail, const QAtomicInt &stop, int id);
+    bool AddByNoFitPolygon(const VLayoutDetail &detail, const QAtomicInt &stop, int id);
 
-    bool SaveResult(const VBestSquare &bestResult, const VLayoutDetail &detail);
+    bool SaveResult(const VBestSquare &bestResult, const VLayoutDetail &detail, int id);
     void SaveCandidate(VBestSquare &bestResult, const VLayoutDetail &detail, int globalI, int detJ, BestFrom type);
 
 };
@@ -35,6 +35,11 @@
 
 #include "vlayoutdetail.h"
 #include "vcontour.h"
+#include "vlayoutstatistics.h"
+#include "vnofitpolygon.h"
+
+class QThreadPool;
+class VNfpCache;
 
 #ifdef Q_CC_GNU
     #pragma GCC diagnostic push
@@ -46,18 +51,24 @@ class VLayoutPaperData : public QSharedData
 public:
     VLayoutPaperData()
         :details(QVector<VLayoutDetail>()), globalContour(VContour()), paperIndex(0), frame(0), layoutWidth(0),
-          rotate(true), rotationIncrease(180)
+          rotate(true), rotationIncrease(180), threadPool(nullptr),
+          statistics(VLayoutStatistics()), placement(Placement::CombineEdges), nfpItems(QVector<VNfpItem>()),
+          nfpCache(nullptr), ids(QVector<int>())
     {}
 
     VLayoutPaperData(int height, int width)
         :details(QVector<VLayoutDetail>()), globalContour(VContour(height, width)), paperIndex(0), frame(0),
-          layoutWidth(0), rotate(true), rotationIncrease(180)
+          layoutWidth(0), rotate(true), rotationIncrease(180), threadPool(nullptr),
+          statistics(VLayoutStatistics()), placement(Placement::CombineEdges), nfpItems(QVector<VNfpItem>()),
+          nfpCache(nullptr), ids(QVector<int>())
     {}
 
     VLayoutPaperData(const VLayoutPaperData &paper)
         :QSharedData(paper), details(paper.details), globalContour(paper.globalContour), paperIndex(paper.paperIndex),
           frame(paper.frame), layoutWidth(paper.layoutWidth), rotate(paper.rotate),
-          rotationIncrease(paper.rotationIncrease)
+          rotationIncrease(paper.rotationIncrease), threadPool(paper.threadPool),
+          statistics(paper.statistics), placement(paper.placement), nfpItems(paper.nfpItems),
+          nfpCache(paper.nfpCache), ids(paper.ids)
     {}
 
     ~VLayoutPaperData() {}
@@ -73,6 +84,24 @@ public:
     qreal layoutWidth;
     bool rotate;
     int rotationIncrease;
+
+    /** @brief threadPool pool for checking positions. If not set global pool will be used. */
+    QThreadPool *threadPool;
+
+    /** @brief statistics counters of all checked positions on this sheet. */
+    VLayoutStatistics statistics;
+
+    /** @brief placement how to search position of a detail. */
+    Placement placement;
+
+    /** @brief nfpItems details arranged by no-fit polygons. Has the same order as details. */
+    QVector<VNfpItem> nfpItems;
+
+    /** @brief nfpCache cache of no-fit polygons shared between sheets. Can be nullptr. */
+    VNfpCache *nfpCache;
+
+    /** @brief ids numbers of arranged details in bank. Has the same order as details. */
+    QVector<int> ids;
 };
 
 #ifdef Q_CC_GNU
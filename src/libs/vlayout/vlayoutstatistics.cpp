@@ -0,0 +1,47 @@
+/************************************************************************
+ **
+ **  @file   vlayoutstatistics.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "vlayoutstatistics.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutStatistics::VLayoutStatistics()
+    :positions(0), outsideSheet(0), boundingBoxCleared(0), hullCleared(0), edgesChecked(0), intersections(0),
+      inside(0), accepted(0)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutStatistics &VLayoutStatistics::operator+=(const VLayoutStatistics &statistics)
+{
+    positions += statistics.positions;
+    outsideSheet += statistics.outsideSheet;
+    boundingBoxCleared += statistics.boundingBoxCleared;
+    hullCleared += statistics.hullCleared;
+    edgesChecked += statistics.edgesChecked;
+    intersections += statistics.intersections;
+    inside += statistics.inside;
+    accepted += statistics.accepted;
+    return *this;
+}
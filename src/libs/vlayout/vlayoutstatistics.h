@@ -0,0 +1,70 @@
+/************************************************************************
+ **
+ **  @file   vlayoutstatistics.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef VLAYOUTSTATISTICS_H
+#define VLAYOUTSTATISTICS_H
+
+#include <QtGlobal>
+
+/**
+ * @brief The VLayoutStatistics class counters of checked positions.
+ *
+ * Each worker counts own positions, results are summed when workers finish. Useful for comparing strategies and
+ * catching performance regressions.
+ */
+class VLayoutStatistics
+{
+public:
+    VLayoutStatistics();
+
+    VLayoutStatistics &operator+=(const VLayoutStatistics &statistics);
+
+    /** @brief positions count of checked positions of details. */
+    qint64 positions;
+
+    /** @brief outsideSheet positions rejected because detail is outside of the sheet. */
+    qint64 outsideSheet;
+
+    /** @brief boundingBoxCleared crossing check finished by comparing bounding boxes. */
+    qint64 boundingBoxCleared;
+
+    /** @brief hullCleared crossing check finished by separating axis test of convex hull. */
+    qint64 hullCleared;
+
+    /** @brief edgesChecked crossing check needed exact intersection of edges. */
+    qint64 edgesChecked;
+
+    /** @brief intersections positions rejected because detail crosses global contour. */
+    qint64 intersections;
+
+    /** @brief inside positions rejected because detail is inside global contour. */
+    qint64 inside;
+
+    /** @brief accepted valid positions. */
+    qint64 accepted;
+};
+
+#endif // VLAYOUTSTATISTICS_H
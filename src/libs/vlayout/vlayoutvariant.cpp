@@ -0,0 +1,277 @@
+/************************************************************************
+ **
+ **  @file   vlayoutvariant.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "vlayoutvariant.h"
+#include "vlayoutdetail.h"
+
+#include <QThreadPool>
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VLayoutVariant constructor.
+ * @param details details with prepared layout allowence.
+ * @param stop flag of canceling generation. Shared between all variants.
+ */
+VLayoutVariant::VLayoutVariant(const QVector<VLayoutDetail> &details, const QAtomicInt &stop)
+    :QRunnable(), details(details), papers(QVector<VLayoutPaper>()), statistics(VLayoutStatistics()), stop(stop),
+      arranged(0), threadPool(new QThreadPool()), layoutWidth(0), caseType(Cases::CaseDesc), paperHeight(0),
+      paperWidth(0), roll(false), placement(Placement::CombineEdges), nfpCache(VNfpCache()), order(QVector<int>()),
+      seed(0), shift(0), rotate(true), rotationIncrease(180), state(LayoutErrors::NoError)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutVariant::~VLayoutVariant()
+{
+    delete threadPool;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::run()
+{
+    papers.clear();
+    statistics = VLayoutStatistics();
+    arranged.store(0);
+    state = LayoutErrors::NoError;
+
+    VBank bank;
+    bank.SetDetails(details);
+    bank.SetLayoutWidth(layoutWidth);
+    bank.SetCaseType(caseType);
+    bank.SetOrder(order);
+    bank.SetSeed(seed);
+
+    if (bank.Prepare() == false)
+    {
+        state = LayoutErrors::PrepareLayoutError;
+        return;
+    }
+
+    while (bank.AllDetailsCount() > 0)
+    {
+        if (stop.load() != 0)
+        {
+            state = LayoutErrors::ProcessStoped;
+            return;
+        }
+
+        VLayoutPaper paper(paperHeight, paperWidth);
+        paper.SetRoll(roll);
+        paper.SetPlacement(placement);
+        paper.SetNfpCache(&nfpCache);
+        paper.SetShift(shift);
+        paper.SetLayoutWidth(bank.GetLayoutWidth());
+        paper.SetPaperIndex(static_cast<quint32>(papers.count()));
+        paper.SetRotate(rotate);
+        paper.SetRotationIncrease(rotationIncrease);
+        paper.SetThreadPool(threadPool);
+        do
+        {
+            const int index = bank.GetTiket();
+            if (paper.ArrangeDetail(bank.GetDetail(index), stop, index))
+            {
+                bank.Arranged(index);
+                arranged.store(bank.ArrangedCount());
+            }
+            else
+            {
+                bank.NotArranged(index);
+            }
+
+            if (stop.load() != 0)
+            {
+                statistics += paper.GetStatistics();
+                if (paper.Count() > 0)
+                {
+                    paper.SetThreadPool(nullptr);
+                    paper.SetNfpCache(nullptr);
+                    papers.append(paper);// Partial result
+                }
+                state = LayoutErrors::ProcessStoped;
+                return;
+            }
+        } while(bank.LeftArrange() > 0);
+
+        statistics += paper.GetStatistics();
+
+        if (paper.Count() > 0)
+        {
+            // Pool and cache will be deleted together with variant.
+            paper.SetThreadPool(nullptr);
+            paper.SetNfpCache(nullptr);
+            papers.append(paper);
+        }
+        else
+        {
+            state = LayoutErrors::EmptyPaperError;
+            return;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetLayoutWidth(qreal width)
+{
+    layoutWidth = width;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetCaseType(Cases caseType)
+{
+    this->caseType = caseType;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetPaperHeight(int value)
+{
+    paperHeight = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetPaperWidth(int value)
+{
+    paperWidth = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetRoll(bool value)
+{
+    roll = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetPlacement(Placement value)
+{
+    placement = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetOrder explicit order of details. See VBank::SetOrder().
+ */
+void VLayoutVariant::SetOrder(const QVector<int> &order)
+{
+    this->order = order;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetSeed seed for choosing between details of one group. See VBank::SetSeed().
+ */
+void VLayoutVariant::SetSeed(quint32 seed)
+{
+    this->seed = seed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetShift(unsigned int shift)
+{
+    this->shift = shift;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetRotate(bool value)
+{
+    rotate = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutVariant::SetRotationIncrease(int value)
+{
+    rotationIncrease = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetThreadsCount how many threads the variant can use for checking positions of a detail.
+ */
+void VLayoutVariant::SetThreadsCount(int count)
+{
+    threadPool->setMaxThreadCount(qMax(1, count));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+LayoutErrors VLayoutVariant::State() const
+{
+    return state;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ArrangedCount count of arranged details. Safe to call while the variant is running.
+ */
+int VLayoutVariant::ArrangedCount() const
+{
+    return arranged.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPaper> VLayoutVariant::GetPapers() const
+{
+    return papers;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutStatistics VLayoutVariant::GetStatistics() const
+{
+    return statistics;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsBetterThan compare results of two finished variants.
+ *
+ * Less sheets always better. With the same count of sheets we prefer more dense last sheet, because other sheets
+ * usually filled equally. On roll we prefer shorter marker.
+ */
+bool VLayoutVariant::IsBetterThan(const VLayoutVariant &variant) const
+{
+    if (state != LayoutErrors::NoError)
+    {
+        return false;
+    }
+
+    if (variant.State() != LayoutErrors::NoError)
+    {
+        return true;
+    }
+
+    if (papers.size() != variant.papers.size())
+    {
+        return papers.size() < variant.papers.size();
+    }
+
+    if (papers.isEmpty())
+    {
+        return false;
+    }
+
+    if (roll && papers.last().MarkerLength() != variant.papers.last().MarkerLength())
+    {
+        return papers.last().MarkerLength() < variant.papers.last().MarkerLength();
+    }
+
+    return papers.last().Efficiency() > variant.papers.last().Efficiency();
+}
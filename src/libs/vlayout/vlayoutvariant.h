@@ -0,0 +1,99 @@
+/************************************************************************
+ **
+ **  @file   vlayoutvariant.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef VLAYOUTVARIANT_H
+#define VLAYOUTVARIANT_H
+
+#include <QRunnable>
+#include <QVector>
+#include <QAtomicInt>
+
+#include "vlayoutdef.h"
+#include "vbank.h"
+#include "vlayoutpaper.h"
+#include "vlayoutstatistics.h"
+#include "vnofitpolygon.h"
+
+class VLayoutDetail;
+class QThreadPool;
+
+/**
+ * @brief The VLayoutVariant class one greedy layout run with own bank and settings.
+ *
+ * Several variants can work at the same time, each with own pool of threads for checking positions.
+ */
+class VLayoutVariant : public QRunnable
+{
+public:
+    VLayoutVariant(const QVector<VLayoutDetail> &details, const QAtomicInt &stop);
+    virtual ~VLayoutVariant();
+
+    virtual void run();
+
+    void SetLayoutWidth(qreal width);
+    void SetCaseType(Cases caseType);
+    void SetPaperHeight(int value);
+    void SetPaperWidth(int value);
+    void SetRoll(bool value);
+    void SetPlacement(Placement value);
+    void SetOrder(const QVector<int> &order);
+    void SetSeed(quint32 seed);
+    void SetShift(unsigned int shift);
+    void SetRotate(bool value);
+    void SetRotationIncrease(int value);
+    void SetThreadsCount(int count);
+
+    LayoutErrors          State() const;
+    int                   ArrangedCount() const;
+    QVector<VLayoutPaper> GetPapers() const;
+    VLayoutStatistics     GetStatistics() const;
+
+    bool IsBetterThan(const VLayoutVariant &variant) const;
+
+private:
+    Q_DISABLE_COPY(VLayoutVariant)
+    QVector<VLayoutDetail> details;
+    QVector<VLayoutPaper> papers;
+    VLayoutStatistics statistics;
+    const QAtomicInt &stop;
+    QAtomicInt arranged;
+    QThreadPool *threadPool;
+    qreal layoutWidth;
+    Cases caseType;
+    int paperHeight;
+    int paperWidth;
+    bool roll;
+    Placement placement;
+    VNfpCache nfpCache;
+    QVector<int> order;
+    quint32 seed;
+    unsigned int shift;
+    bool rotate;
+    int rotationIncrease;
+    LayoutErrors state;
+};
+
+#endif // VLAYOUTVARIANT_H
@@ -0,0 +1,235 @@
+/************************************************************************
+ **
+ **  @file   vnofitpolygon.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+
+#include "vnofitpolygon.h"
+#include "vlayoutdetail.h"
+#include "vspatialindex.h"
+
+#include <QLineF>
+#include <QRectF>
+#include <QtMath>
+
+namespace
+{
+// Points closer to border of polygon than this distance are treated as touching.
+const qreal nfpTolerance = 0.01;
+
+//---------------------------------------------------------------------------------------------------------------------
+void AppendIntersection(const QLineF &line1, const QLineF &line2, QVector<QPointF> &points)
+{
+    QPointF point;
+    if (line1.intersect(line2, &point) == QLineF::BoundedIntersection)
+    {
+        points.append(point);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint64 Orientation(const VNfpItem &item)
+{
+    return (static_cast<quint64>(item.mirror ? 1 : 0) << 9) | static_cast<quint64>(item.angle % 360);
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Convex no-fit polygon of two convex polygons.
+ * @param fixed convex hull of fixed detail.
+ * @param moving convex hull of moving detail. Translation of this polygon is a reference point.
+ * @return convex polygon of translations where moving polygon overlaps fixed.
+ */
+QVector<QPointF> VNoFitPolygon::Convex(const QVector<QPointF> &fixed, const QVector<QPointF> &moving)
+{
+    QVector<QPointF> sum;
+    sum.reserve(fixed.size()*moving.size());
+    for (int i = 0; i < fixed.size(); ++i)
+    {
+        for (int j = 0; j < moving.size(); ++j)
+        {
+            sum.append(fixed.at(i) - moving.at(j));
+        }
+    }
+    return VLayoutDetail::ConvexHull(sum);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief StrictlyContains check if point is inside of convex polygon. Points on border are outside.
+ */
+bool VNoFitPolygon::StrictlyContains(const QVector<QPointF> &polygon, const QPointF &point)
+{
+    if (polygon.size() < 3)
+    {
+        return false;
+    }
+
+    int positive = 0;
+    int negative = 0;
+    for (int i = 0; i < polygon.size(); ++i)
+    {
+        const QPointF &p1 = polygon.at(i);
+        const QPointF &p2 = polygon.at((i+1) % polygon.size());
+        const qreal dx = p2.x() - p1.x();
+        const qreal dy = p2.y() - p1.y();
+        const qreal length = qSqrt(dx*dx + dy*dy);
+        if (qFuzzyIsNull(length))
+        {
+            continue;
+        }
+
+        const qreal distance = (dx*(point.y() - p1.y()) - dy*(point.x() - p1.x()))/length;
+        if (distance > nfpTolerance)
+        {
+            ++positive;
+        }
+        else if (distance < -nfpTolerance)
+        {
+            ++negative;
+        }
+        else
+        {
+            return false;// On border
+        }
+
+        if (positive > 0 && negative > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates list of positions where moving detail can touch other details or borders of sheet.
+ *
+ * Lowest valid position always is a vertex of no-fit polygon or inner-fit rectangle or intersection of their edges.
+ * @param polygons no-fit polygons of all arranged details.
+ * @param innerFit rectangle of translations that keep detail inside of sheet.
+ * @return positions inside of inner-fit rectangle. Can contain invalid positions.
+ */
+QVector<QPointF> VNoFitPolygon::Candidates(const QVector<QVector<QPointF> > &polygons, const QRectF &innerFit)
+{
+    QVector<QPointF> points;
+    points.append(innerFit.topLeft());
+    points.append(innerFit.topRight());
+    points.append(innerFit.bottomLeft());
+    points.append(innerFit.bottomRight());
+
+    const QLineF borders[] = {QLineF(innerFit.topLeft(), innerFit.topRight()),
+                              QLineF(innerFit.topRight(), innerFit.bottomRight()),
+                              QLineF(innerFit.bottomRight(), innerFit.bottomLeft()),
+                              QLineF(innerFit.bottomLeft(), innerFit.topLeft())};
+
+    // Intersections of no-fit polygons. Index gives only edges which bounding rectangles touch, so we don't check
+    // all pairs of edges.
+    QVector<QLineF> edges;
+    QVector<int> owners;
+    for (int i = 0; i < polygons.size(); ++i)
+    {
+        const QVector<QPointF> &polygon = polygons.at(i);
+        points += polygon;
+
+        for (int k = 0; k < polygon.size(); ++k)
+        {
+            const QLineF edge(polygon.at(k), polygon.at((k+1) % polygon.size()));
+            for (int b = 0; b < 4; ++b)
+            {
+                AppendIntersection(edge, borders[b], points);
+            }
+            edges.append(edge);
+            owners.append(i);
+        }
+    }
+
+    VSpatialIndex index;
+    index.Build(edges);
+
+    QVector<int> nearest;
+    for (int i = 0; i < edges.size(); ++i)
+    {
+        index.Candidates(edges.at(i), nearest);
+        for (int k = 0; k < nearest.size(); ++k)
+        {
+            const int j = nearest.at(k) - 1;
+            // Each pair only once. Edges of one convex polygon don't cross.
+            if (j > i && owners.at(j) != owners.at(i))
+            {
+                AppendIntersection(edges.at(i), edges.at(j), points);
+            }
+        }
+    }
+
+    const QRectF area = innerFit.adjusted(-nfpTolerance, -nfpTolerance, nfpTolerance, nfpTolerance);
+    QVector<QPointF> inside;
+    inside.reserve(points.size());
+    for (int i = 0; i < points.size(); ++i)
+    {
+        if (area.contains(points.at(i)))
+        {
+            inside.append(points.at(i));
+        }
+    }
+    return inside;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VNfpCache::VNfpCache()
+    :polygons(QHash<quint64, QVector<QPointF> >())
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Polygon no-fit polygon of two details without translation of fixed detail.
+ */
+QVector<QPointF> VNfpCache::Polygon(const VNfpItem &fixed, const VNfpItem &moving)
+{
+    if (fixed.id < 0 || moving.id < 0)
+    {
+        return VNoFitPolygon::Convex(fixed.hull, moving.hull);
+    }
+
+    // 20 bits for number of detail, 9 bits for angle and 1 bit for mirror
+    const quint64 key = (static_cast<quint64>(fixed.id) << 40) | (Orientation(fixed) << 30) |
+                        (static_cast<quint64>(moving.id) << 10) | Orientation(moving);
+
+    auto polygon = polygons.constFind(key);
+    if (polygon != polygons.constEnd())
+    {
+        return polygon.value();
+    }
+
+    const QVector<QPointF> nfp = VNoFitPolygon::Convex(fixed.hull, moving.hull);
+    polygons.insert(key, nfp);
+    return nfp;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VNfpCache::Count() const
+{
+    return polygons.size();
+}
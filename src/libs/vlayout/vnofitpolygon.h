@@ -0,0 +1,100 @@
+/************************************************************************
+ **
+ **  @file   vnofitpolygon.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+
+#ifndef VNOFITPOLYGON_H
+#define VNOFITPOLYGON_H
+
+#include <QVector>
+#include <QPointF>
+#include <QHash>
+#include <QTransform>
+
+class QRectF;
+
+/**
+ * @brief The VNfpItem struct detail arranged by no-fit polygons.
+ */
+struct VNfpItem
+{
+    VNfpItem()
+        :id(-1), angle(0), mirror(false), matrix(QTransform()), offset(QPointF()), hull(QVector<QPointF>())
+    {}
+
+    /** @brief id number of detail in bank. -1 if unknown. */
+    int id;
+
+    /** @brief angle rotation of detail in degrees. */
+    int angle;
+
+    /** @brief mirror detail was mirrored before rotation. */
+    bool mirror;
+
+    /** @brief matrix incoming matrix of detail with mirroring and rotation, without translation. */
+    QTransform matrix;
+
+    /** @brief offset translation of detail after rotation. */
+    QPointF offset;
+
+    /** @brief hull convex hull of rotated detail without translation. */
+    QVector<QPointF> hull;
+};
+
+/**
+ * @brief The VNoFitPolygon class no-fit polygons of convex hulls.
+ *
+ * No-fit polygon of fixed and moving polygons is a set of translations of moving polygon where it overlaps fixed
+ * polygon. For convex polygons it is Minkowski sum of fixed polygon and reflected moving polygon. Using convex hulls
+ * we lose a bit of density for concave details, but each found position is valid without any additional check.
+ */
+class VNoFitPolygon
+{
+public:
+    static QVector<QPointF> Convex(const QVector<QPointF> &fixed, const QVector<QPointF> &moving);
+    static bool             StrictlyContains(const QVector<QPointF> &polygon, const QPointF &point);
+    static QVector<QPointF> Candidates(const QVector<QVector<QPointF> > &polygons, const QRectF &innerFit);
+};
+
+/**
+ * @brief The VNfpCache class cache of no-fit polygons for pairs (detail, rotation).
+ *
+ * No-fit polygon doesn't depend on position of fixed detail, so one polygon can be used for all sheets. Key is number
+ * of detail with angle and mirroring, so incoming matrices of details must not change while cache is used. Not thread
+ * safe, each layout variant has own cache.
+ */
+class VNfpCache
+{
+public:
+    VNfpCache();
+
+    QVector<QPointF> Polygon(const VNfpItem &fixed, const VNfpItem &moving);
+    int Count() const;
+
+private:
+    QHash<quint64, QVector<QPointF> > polygons;
+};
+
+#endif // VNOFITPOLYGON_H
@@ -27,6 +27,7 @@
  *************************************************************************/
 
 #include "vposition.h"
+#include "vspatialindex.h"
 
 #include <QPointF>
 #include <QRectF>
@@ -35,13 +36,25 @@
 #include <QPainterPath>
 #include <QImage>
 #include <QPainter>
-#include <QCoreApplication>
+#include <QtMath>
+#include <algorithm>
 
 //---------------------------------------------------------------------------------------------------------------------
-VPosition::VPosition(const VContour &gContour, int j, const VLayoutDetail &detail, int i, bool *stop, bool rotate,
-                     int rotationIncrease)
-    :QRunnable(), bestResult(VBestSquare()), gContour(gContour), detail(detail), i(i), j(j), paperIndex(0), frame(0),
-      detailsCount(0), details(QVector<VLayoutDetail>()), stop(stop), rotate(rotate), rotationIncrease(rotationIncrease)
+/**
+ * @brief VPosition constructor.
+ * @param gContour global contour. Shared between all workers and never changed by them.
+ * @param index spatial index of global contour edges.
+ * @param detail detail we arrange.
+ * @param nextCandidate counter of candidates shared between all workers. Each worker takes from it next chunk of
+ * candidates until all of them will be checked.
+ * @param stop flag of canceling generation.
+ */
+VPosition::VPosition(const VContour &gContour, const VSpatialIndex &index, const VLayoutDetail &detail,
+                     QAtomicInt &nextCandidate, const QAtomicInt &stop, bool rotate, int rotationIncrease)
+    :QRunnable(), bestResult(VBestSquare()), chunkResults(QMap<int, VBestSquare>()), statistics(VLayoutStatistics()),
+      gContour(gContour), index(index), detail(detail), i(0), j(0), paperIndex(0), frame(0), baseFrame(0),
+      detailsCount(0), details(QVector<VLayoutDetail>()), nextCandidate(nextCandidate), stop(stop), rotate(rotate),
+      rotationIncrease(rotationIncrease)
 {
     if ((rotationIncrease >= 1 && rotationIncrease <= 180 && 360 % rotationIncrease == 0) == false)
     {
@@ -50,15 +63,67 @@ VPosition::VPosition(const VContour &gContour, int j, const VLayoutDetail &detai
 }
 
 //---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief run check candidates chunk by chunk.
+ *
+ * Candidate is a pair (global edge, detail edge). Candidates numbered so neighbors share the same global edge,
+ * that's why each chunk works with small part of global contour. Which worker gets a chunk depends on scheduling, so we
+ * keep result of each chunk separately. Merging them in order of chunks gives the same layout every time.
+ */
 void VPosition::run()
 {
-    QCoreApplication::processEvents();
+    const int detailEdges = detail.EdgesCount();
+    const int total = CandidatesCount(index.EdgesCount(), detailEdges);
 
-    if (*stop)
+    while (stop.load() == 0)
     {
-        return;
+        const int from = nextCandidate.fetchAndAddOrdered(ChunkSize);
+        if (from >= total)
+        {
+            return;
+        }
+
+        bestResult = VBestSquare();
+        const int to = qMin(from + ChunkSize, total);
+        for (int k = from; k < to; ++k)
+        {
+            if (stop.load() != 0)
+            {
+                return;
+            }
+
+            j = k / detailEdges + 1;
+            i = k % detailEdges + 1;
+            frame = baseFrame + static_cast<quint32>(k)*FramesPerCandidate(rotationIncrease);
+
+            FindBestPosition();
+        }
+
+        if (bestResult.ValideResult())
+        {
+            chunkResults.insert(from, bestResult);
+        }
     }
+}
 
+//---------------------------------------------------------------------------------------------------------------------
+int VPosition::CandidatesCount(int globalEdges, int detailEdges)
+{
+    return globalEdges*detailEdges;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FramesPerCandidate number of debug frames for each candidate.
+ */
+quint32 VPosition::FramesPerCandidate(int rotationIncrease)
+{
+    return static_cast<quint32>(3 + 360/rotationIncrease*2);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPosition::FindBestPosition()
+{
     // We should use copy of the detail.
     VLayoutDetail workDetail = detail;
 
@@ -103,13 +168,13 @@ void VPosition::setPaperIndex(const quint32 &value)
 //---------------------------------------------------------------------------------------------------------------------
 quint32 VPosition::getFrame() const
 {
-    return frame;
+    return baseFrame;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 void VPosition::setFrame(const quint32 &value)
 {
-    frame = value;
+    baseFrame = value;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -131,9 +196,15 @@ void VPosition::setDetails(const QVector<VLayoutDetail> &details)
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VBestSquare VPosition::getBestResult() const
+QMap<int, VBestSquare> VPosition::getChunkResults() const
 {
-    return bestResult;
+    return chunkResults;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutStatistics VPosition::getStatistics() const
+{
+    return statistics;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -187,15 +258,23 @@ void VPosition::DrawDebug(const VContour &contour, const VLayoutDetail &detail,
 void VPosition::SaveCandidate(VBestSquare &bestResult, const VLayoutDetail &detail, int globalI, int detJ,
                               BestFrom type)
 {
+    ++statistics.accepted;
     QVector<QPointF> newGContour = gContour.UniteWithContour(detail, globalI, detJ, type);
     newGContour.append(newGContour.first());
     const QRectF rec = QPolygonF(newGContour).boundingRect();
-    bestResult.NewResult(static_cast<qint64>(rec.width()*rec.height()), globalI, detJ, detail.GetMatrix(),
-                         detail.IsMirror(), type);
+
+    qint64 square = static_cast<qint64>(rec.width()*rec.height());
+    if (gContour.IsRoll())
+    {
+        // On roll first of all we save length of marker, width of bounding rectangle only decides between equal.
+        square = static_cast<qint64>(qCeil(rec.height()))*(gContour.GetWidth()+1) + qCeil(rec.width());
+    }
+
+    bestResult.NewResult(square, globalI, detJ, detail.GetMatrix(), detail.IsMirror(), type);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-bool VPosition::CheckCombineEdges(VLayoutDetail &detail, int j, int &dEdge) const
+bool VPosition::CheckCombineEdges(VLayoutDetail &detail, int j, int &dEdge)
 {
     const QLineF globalEdge = gContour.GlobalEdge(j);
     bool flagMirror = false;
@@ -209,11 +288,7 @@ bool VPosition::CheckCombineEdges(VLayoutDetail &detail, int j, int &dEdge) cons
 #   endif
 #endif
 
-    CrossingType type = CrossingType::Intersection;
-    if (SheetContains(detail.BoundingRect()))
-    {
-        type = Crossing(detail, j, dEdge);
-    }
+    const CrossingType type = CheckCrossing(detail, j, dEdge);
 
     switch (type)
     {
@@ -258,11 +333,7 @@ bool VPosition::CheckCombineEdges(VLayoutDetail &detail, int j, int &dEdge) cons
             return false;
         }
 
-        CrossingType type = CrossingType::Intersection;
-        if (SheetContains(detail.BoundingRect()))
-        {
-            type = Crossing(detail, j, dEdge);
-        }
+        const CrossingType type = CheckCrossing(detail, j, dEdge);
 
         switch (type)
         {
@@ -295,7 +366,7 @@ bool VPosition::CheckCombineEdges(VLayoutDetail &detail, int j, int &dEdge) cons
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-bool VPosition::CheckRotationEdges(VLayoutDetail &detail, int j, int dEdge, int angle) const
+bool VPosition::CheckRotationEdges(VLayoutDetail &detail, int j, int dEdge, int angle)
 {
     const QLineF globalEdge = gContour.GlobalEdge(j);
     bool flagSquare = false;
@@ -308,11 +379,7 @@ bool VPosition::CheckRotationEdges(VLayoutDetail &detail, int j, int dEdge, int
     #endif
 #endif
 
-    CrossingType type = CrossingType::Intersection;
-    if (SheetContains(detail.BoundingRect()))
-    {
-        type = Crossing(detail, j, dEdge);
-    }
+    const CrossingType type = CheckCrossing(detail, j, dEdge);
 
     switch (type)
     {
@@ -344,12 +411,33 @@ bool VPosition::CheckRotationEdges(VLayoutDetail &detail, int j, int dEdge, int
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VPosition::CrossingType VPosition::Crossing(const VLayoutDetail &detail, const int &globalI, const int &detailI) const
+/**
+ * @brief CheckCrossing check that detail is inside of the sheet and doesn't cross global contour.
+ */
+VPosition::CrossingType VPosition::CheckCrossing(const VLayoutDetail &detail, int j, int dEdge)
+{
+    ++statistics.positions;
+
+    if (SheetContains(detail.BoundingRect()) == false)
+    {
+        ++statistics.outsideSheet;
+        return CrossingType::Intersection;
+    }
+
+    const CrossingType type = Crossing(detail, j, dEdge);
+    if (type == CrossingType::Intersection)
+    {
+        ++statistics.intersections;
+    }
+    return type;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VPosition::CrossingType VPosition::Crossing(const VLayoutDetail &detail, const int &globalI, const int &detailI)
 {
-    int globalEdgesCount = gContour.EdgesCount();
-    if (globalEdgesCount == 0)
+    if (index.HasNullEdge() || detail.HasNullEdge()) // Got null edge
     {
-        globalEdgesCount = 1;// For blank sheet
+        return CrossingType::EdgeError;
     }
 
     const int detailEdgesCount = detail.EdgesCount();
@@ -358,33 +446,65 @@ VPosition::CrossingType VPosition::Crossing(const VLayoutDetail &detail, const i
         return CrossingType::EdgeError;
     }
 
-    for(int i = 1; i <= globalEdgesCount; i++)
+    // Stage 1. Bounding rectangle of the detail against bounding rectangles of global edges.
+    QVector<int> suspects;
+    index.Candidates(detail.BoundingRect(), suspects);
+    if (suspects.isEmpty())
+    {
+        ++statistics.boundingBoxCleared;
+        return CrossingType::NoIntersection;
+    }
+
+    // Stage 2. Separating axis test between convex hull of the detail and each global edge.
+    const QVector<QPointF> hull = detail.GetConvexHull();
+    const qreal orientation = HullOrientation(hull);
+    int count = 0;
+    for (int k = 0; k < suspects.size(); ++k)
     {
-        const QLineF globalEdge = gContour.GlobalEdge(i);
-        if (globalEdge.isNull()) // Got null edge
+        if (SeparatedByHull(hull, orientation, index.Edge(suspects.at(k))) == false)
         {
-            return CrossingType::EdgeError;
+            suspects[count++] = suspects.at(k);
         }
+    }
+    suspects.resize(count);
+
+    if (suspects.isEmpty())
+    {
+        ++statistics.hullCleared;
+        return CrossingType::NoIntersection;
+    }
+
+    // Stage 3. Exact intersection of edges.
+    ++statistics.edgesChecked;
+    const QLineF gEdge = index.Edge(globalI);
+    const QLineF dEdge = detail.Edge(detailI);
+    QVector<int> candidates;
 
-        for(int j = 1; j <= detailEdgesCount; j++)
+    for(int j = 1; j <= detailEdgesCount; j++)
+    {
+        const QLineF detailEdge = detail.Edge(j);
+
+        // Check only global edges that are close enough to the detail edge.
+        index.Candidates(detailEdge, candidates);
+        for(int c = 0; c < candidates.size(); c++)
         {
+            const int i = candidates.at(c);
             if (i == globalI && j == detailI)
             {
                 continue;
             }
 
-            const QLineF detailEdge = detail.Edge(j);
-            if (detailEdge.isNull()) // Got null edge
+            if (std::binary_search(suspects.constBegin(), suspects.constEnd(), i) == false)
             {
-                return CrossingType::EdgeError;
+                continue;// Rejected on previous stages
             }
 
             QPointF xPoint;
-            QLineF::IntersectType type = globalEdge.intersect(detailEdge, &xPoint);
+            const QLineF::IntersectType type = index.Edge(i).intersect(detailEdge, &xPoint);
 
             if (type == QLineF::BoundedIntersection)
             {
-                if (TrueIntersection(gContour.GlobalEdge(globalI), detail.Edge(detailI), xPoint))
+                if (TrueIntersection(gEdge, dEdge, xPoint))
                 {
                     return CrossingType::Intersection;
                 }
@@ -396,7 +516,89 @@ VPosition::CrossingType VPosition::Crossing(const VLayoutDetail &detail, const i
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VPosition::InsideType VPosition::InsideContour(const VLayoutDetail &detail, const int &detailI) const
+/**
+ * @brief HullOrientation sign of hull area. Mirrored detail has reversed order of hull vertices.
+ */
+qreal VPosition::HullOrientation(const QVector<QPointF> &hull)
+{
+    qreal area = 0;
+    for (int i = 0; i < hull.size(); ++i)
+    {
+        const QPointF &a = hull.at(i);
+        const QPointF &b = hull.at((i+1) % hull.size());
+        area += a.x()*b.y() - b.x()*a.y();
+    }
+    return area < 0 ? -1 : 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SeparatedByHull separating axis test for convex hull and segment.
+ *
+ * For convex polygon enough to check outer half-planes of hull edges and normal of the segment. Touching is not
+ * separation, such cases will be checked by exact test.
+ * @return true if the segment for sure doesn't touch the hull.
+ */
+bool VPosition::SeparatedByHull(const QVector<QPointF> &hull, qreal orientation, const QLineF &edge)
+{
+    if (hull.size() < 3)
+    {
+        return false;
+    }
+
+    const qreal tolerance = 1.0;
+
+    for (int i = 0; i < hull.size(); ++i)
+    {
+        const QPointF &a = hull.at(i);
+        const QPointF &b = hull.at((i+1) % hull.size());
+
+        // Outer normal of hull edge
+        const qreal nx = (b.y() - a.y())*orientation;
+        const qreal ny = -(b.x() - a.x())*orientation;
+        const qreal limit = nx*a.x() + ny*a.y() + tolerance*qSqrt(nx*nx + ny*ny);
+
+        if (nx*edge.x1() + ny*edge.y1() > limit && nx*edge.x2() + ny*edge.y2() > limit)
+        {
+            return true;
+        }
+    }
+
+    const qreal nx = edge.y2() - edge.y1();
+    const qreal ny = -(edge.x2() - edge.x1());
+    const qreal length = qSqrt(nx*nx + ny*ny);
+    if (length <= 0)
+    {
+        return false;
+    }
+
+    const qreal base = nx*edge.x1() + ny*edge.y1();
+    bool left = false;
+    bool right = false;
+    for (int i = 0; i < hull.size(); ++i)
+    {
+        const qreal side = nx*hull.at(i).x() + ny*hull.at(i).y() - base;
+        if (side < tolerance*length)
+        {
+            left = true;
+        }
+
+        if (side > -tolerance*length)
+        {
+            right = true;
+        }
+
+        if (left && right)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VPosition::InsideType VPosition::InsideContour(const VLayoutDetail &detail, const int &detailI)
 {
     if (detail.EdgesCount() < 3)
     {
@@ -418,38 +620,13 @@ VPosition::InsideType VPosition::InsideContour(const VLayoutDetail &detail, cons
         {
             if (CheckSide(globalEdge, lPoints.at(i)) < 0)
             {
+                ++statistics.inside;
                 return InsideType::Inside;
             }
         }
     }
     else
     {
-        const int polyCorners = gContour.EdgesCount();
-        int j = polyCorners-1;
-
-        QVector<qreal> constant;
-        QVector<qreal> multiple;
-
-        for(int i=0; i<polyCorners; i++)
-        {
-            const qreal xi = gContour.at(i).x();
-            const qreal xj = gContour.at(j).x();
-            const qreal yi = gContour.at(i).y();
-            const qreal yj = gContour.at(j).y();
-            if(qFuzzyCompare(yj, yi))
-            {
-                constant.insert(i, xi);
-                multiple.insert(i, 0);
-            }
-            else
-            {
-                constant.insert(i, xi - (yi*xj)/(yj-yi) + (yi*xi)/(yj-yi));
-                multiple.insert(i, (xj-xi)/(yj-yi));
-            }
-
-            j=i;
-        }
-
         for(int m = 1; m <= detail.EdgesCount(); ++m)
         {
             if (m == detailI)
@@ -466,24 +643,10 @@ VPosition::InsideType VPosition::InsideContour(const VLayoutDetail &detail, cons
             const QVector<QPointF> p = Triplet(detailEdge);
             for (int n=0; n<p.size(); ++n )
             {
-                int j = polyCorners-1;
-                bool oddNodes = false;
-
-                for (int i=0; i<polyCorners; i++)
-                {
-                    const qreal yi = gContour.at(i).y();
-                    const qreal yj = gContour.at(j).y();
-
-                    if (((yi < p.at(n).y() && yj >= p.at(n).y()) || (yj < p.at(n).y() && yi >= p.at(n).y())))
-                    {
-                        oddNodes ^= (p.at(n).y() * multiple.at(i) + constant.at(i) < p.at(n).x());
-                    }
-
-                    j=i;
-                }
-
-                if (oddNodes)
+                // Index was built for the same global contour.
+                if (index.InsidePolygon(p.at(n)))
                 {
+                    ++statistics.inside;
                     return InsideType::Inside;
                 }
             }
@@ -501,8 +664,7 @@ qreal VPosition::CheckSide(const QLineF &edge, const QPointF &p) const
 //---------------------------------------------------------------------------------------------------------------------
 bool VPosition::SheetContains(const QRectF &rect) const
 {
-    const QRectF bRect(0, 0, gContour.GetWidth(), gContour.GetHeight());
-    return bRect.contains(rect);
+    return gContour.Contains(rect);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -604,13 +766,11 @@ void VPosition::Rotate(int increase)
 {
     for (int angle = 0; angle <= 360; angle = angle+increase)
     {
-        if (*stop)
+        if (stop.load() != 0)
         {
             return;
         }
 
-        QCoreApplication::processEvents();
-
         // We should use copy of the detail.
         VLayoutDetail workDetail = detail;
 
@@ -31,12 +31,16 @@
 
 #include <QRunnable>
 #include <QVector>
+#include <QAtomicInt>
+#include <QMap>
 
 #include "vlayoutdef.h"
 #include "vbestsquare.h"
 #include "vcontour.h"
 #include "vlayoutdetail.h"
+#include "vlayoutstatistics.h"
 
+class VSpatialIndex;
 class QPointF;
 class QRectF;
 class QLineF;
@@ -46,8 +50,8 @@ class QPainterPath;
 class VPosition : public QRunnable
 {
 public:
-    VPosition(const VContour &gContour, int j, const VLayoutDetail &detail, int i, bool *stop, bool rotate,
-              int rotationIncrease);
+    VPosition(const VContour &gContour, const VSpatialIndex &index, const VLayoutDetail &detail,
+              QAtomicInt &nextCandidate, const QAtomicInt &stop, bool rotate, int rotationIncrease);
     virtual ~VPosition(){}
 
     virtual void run();
@@ -63,7 +67,14 @@ public:
 
     void setDetails(const QVector<VLayoutDetail> &details);
 
-    VBestSquare getBestResult() const;
+    QMap<int, VBestSquare> getChunkResults() const;
+    VLayoutStatistics getStatistics() const;
+
+    /** @brief ChunkSize how many candidates a worker takes at once. */
+    static const int ChunkSize = 16;
+
+    static int     CandidatesCount(int globalEdges, int detailEdges);
+    static quint32 FramesPerCandidate(int rotationIncrease);
 
     static void DrawDebug(const VContour &contour, const VLayoutDetail &detail, int frame, quint32 paperIndex,
                           int detailsCount, const QVector<VLayoutDetail> &details = QVector<VLayoutDetail>());
@@ -71,15 +82,21 @@ public:
 private:
     Q_DISABLE_COPY(VPosition)
     VBestSquare bestResult;
+    /** @brief chunkResults the best result of each checked chunk. Key is the first candidate of chunk. */
+    QMap<int, VBestSquare> chunkResults;
+    VLayoutStatistics statistics;
     const VContour gContour;
+    const VSpatialIndex &index;
     const VLayoutDetail detail;
     int i;
     int j;
     quint32 paperIndex;
     quint32 frame;
+    quint32 baseFrame;
     quint32 detailsCount;
     QVector<VLayoutDetail> details;
-    bool *stop;
+    QAtomicInt &nextCandidate;
+    const QAtomicInt &stop;
     bool rotate;
     int rotationIncrease;
 
@@ -97,16 +114,21 @@ private:
         EdgeError = 2
     };
 
+    void FindBestPosition();
     void SaveCandidate(VBestSquare &bestResult, const VLayoutDetail &detail, int globalI, int detJ, BestFrom type);
 
-    bool CheckCombineEdges(VLayoutDetail &detail, int j, int &dEdge) const;
-    bool CheckRotationEdges(VLayoutDetail &detail, int j, int dEdge, int angle) const;
+    bool CheckCombineEdges(VLayoutDetail &detail, int j, int &dEdge);
+    bool CheckRotationEdges(VLayoutDetail &detail, int j, int dEdge, int angle);
 
-    CrossingType Crossing(const VLayoutDetail &detail, const int &globalI, const int &detailI) const;
-    InsideType   InsideContour(const VLayoutDetail &detail, const int &detailI) const;
+    CrossingType CheckCrossing(const VLayoutDetail &detail, int j, int dEdge);
+    CrossingType Crossing(const VLayoutDetail &detail, const int &globalI, const int &detailI);
+    InsideType   InsideContour(const VLayoutDetail &detail, const int &detailI);
     qreal        CheckSide(const QLineF &edge, const QPointF &p) const;
     bool         SheetContains(const QRectF &rect) const;
 
+    static qreal HullOrientation(const QVector<QPointF> &hull);
+    static bool  SeparatedByHull(const QVector<QPointF> &hull, qreal orientation, const QLineF &edge);
+
     void CombineEdges(VLayoutDetail &detail, const QLineF &globalEdge, const int &dEdge) const;
     void RotateEdges(VLayoutDetail &detail, const QLineF &globalEdge, int dEdge, int angle) const;
 
@@ -0,0 +1,440 @@
+/************************************************************************
+ **
+ **  @file   vspatialindex.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "vspatialindex.h"
+#include "vcontour.h"
+
+#include <QRectF>
+#include <QPointF>
+#include <QtMath>
+#include <algorithm>
+
+namespace
+{
+// Tolerance for bounding boxes. Points of the contour and a detail can touch each other.
+const qreal indexTolerance = 1.0;
+// Protect us from huge grids for very long and thin contours.
+const int maxCells = 1 << 16;
+// Each edge can cross many slabs. Above this limit we use simple ray casting.
+const int maxSlabEdges = 1 << 20;
+// Edges that touch each other on a border of slab can have slightly different x because of rounding.
+const qreal slabTolerance = 0.001;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VSpatialIndex::VSpatialIndex()
+    :edges(QVector<QLineF>()), cells(QVector<QVector<int> >()), left(0), top(0), cellSize(1), columns(0), rows(0),
+      nullEdge(false), polygonEdges(QVector<VSlabEdge>()), slabY(QVector<qreal>()), slabStart(QVector<int>()),
+      slabEdges(QVector<VSlabEdge>()), slabCrossed(QVector<bool>())
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+VSpatialIndex::VSpatialIndex(const VContour &contour)
+    :VSpatialIndex()
+{
+    Build(contour);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSpatialIndex::Build(const VContour &contour)
+{
+    BuildSlabs(contour);
+
+    QVector<QLineF> contourEdges;
+    contourEdges.reserve(contour.EdgesCount());
+    for (int i = 1; i <= contour.EdgesCount(); ++i)
+    {
+        contourEdges.append(contour.GlobalEdge(i));
+    }
+    BuildGrid(contourEdges);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Build index for arbitrary edges. Edges don't need to form a polygon, so InsidePolygon() always returns false.
+ * @param lines edges. Number of edge in results = index in vector + 1.
+ */
+void VSpatialIndex::Build(const QVector<QLineF> &lines)
+{
+    polygonEdges.clear();
+    slabY.clear();
+    slabStart.clear();
+    slabEdges.clear();
+    slabCrossed.clear();
+
+    BuildGrid(lines);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSpatialIndex::BuildGrid(const QVector<QLineF> &lines)
+{
+    edges = lines;
+    cells.clear();
+    nullEdge = false;
+
+    qreal minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int i = 0; i < edges.size(); ++i)
+    {
+        const QLineF &edge = edges.at(i);
+        if (edge.isNull())
+        {
+            nullEdge = true;
+        }
+
+        if (i == 0)
+        {
+            minX = qMin(edge.x1(), edge.x2());
+            maxX = qMax(edge.x1(), edge.x2());
+            minY = qMin(edge.y1(), edge.y2());
+            maxY = qMax(edge.y1(), edge.y2());
+        }
+        else
+        {
+            minX = qMin(minX, qMin(edge.x1(), edge.x2()));
+            maxX = qMax(maxX, qMax(edge.x1(), edge.x2()));
+            minY = qMin(minY, qMin(edge.y1(), edge.y2()));
+            maxY = qMax(maxY, qMax(edge.y1(), edge.y2()));
+        }
+    }
+
+    if (edges.isEmpty())
+    {
+        columns = 0;
+        rows = 0;
+        return;
+    }
+
+    left = minX - indexTolerance;
+    top = minY - indexTolerance;
+    const qreal width = maxX - minX + 2*indexTolerance;
+    const qreal height = maxY - minY + 2*indexTolerance;
+
+    // Approximately one edge per cell.
+    cellSize = qMax(width, height)/qMax(1, qCeil(qSqrt(edges.size())));
+    cellSize = qMax(cellSize, qSqrt(width*height/maxCells));
+    cellSize = qMax(cellSize, 1.0);
+
+    columns = qFloor(width/cellSize) + 1;
+    rows = qFloor(height/cellSize) + 1;
+    cells.resize(columns*rows);
+
+    for (int i = 0; i < edges.size(); ++i)
+    {
+        const QLineF &edge = edges.at(i);
+        const int c1 = Column(qMin(edge.x1(), edge.x2()));
+        const int c2 = Column(qMax(edge.x1(), edge.x2()));
+        const int r1 = Row(qMin(edge.y1(), edge.y2()));
+        const int r2 = Row(qMax(edge.y1(), edge.y2()));
+
+        for (int r = r1; r <= r2; ++r)
+        {
+            for (int c = c1; c <= c2; ++c)
+            {
+                cells[r*columns + c].append(i+1);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSpatialIndex::EdgesCount() const
+{
+    return edges.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Edge return cached global edge.
+ * @param i number of edge. Numeration the same as in VContour::GlobalEdge().
+ */
+const QLineF &VSpatialIndex::Edge(int i) const
+{
+    return edges.at(i-1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VSpatialIndex::HasNullEdge() const
+{
+    return nullEdge;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates find global edges that can intersect the line.
+ * @param line detail edge.
+ * @param result sorted numbers of global edges without duplicates.
+ */
+void VSpatialIndex::Candidates(const QLineF &line, QVector<int> &result) const
+{
+    Query(qMin(line.x1(), line.x2()), qMin(line.y1(), line.y2()), qMax(line.x1(), line.x2()),
+          qMax(line.y1(), line.y2()), result);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates find global edges which bounding rectangles touch the rectangle.
+ * @param rect bounding rectangle of a detail.
+ * @param result sorted numbers of global edges without duplicates.
+ */
+void VSpatialIndex::Candidates(const QRectF &rect, QVector<int> &result) const
+{
+    Query(rect.left(), rect.top(), rect.right(), rect.bottom(), result);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief InsidePolygon check if point inside exact polygon of global contour. Uses the same even-odd rule as
+ * classical ray casting, but in O(log N).
+ */
+bool VSpatialIndex::InsidePolygon(const QPointF &p) const
+{
+    if (slabStart.isEmpty())
+    {
+        bool oddNodes = false;
+        for (int i = 0; i < polygonEdges.size(); ++i)
+        {
+            const VSlabEdge &edge = polygonEdges.at(i);
+            if (edge.minY < p.y() && edge.maxY >= p.y())
+            {
+                oddNodes ^= (edge.X(p.y()) < p.x());
+            }
+        }
+        return oddNodes;
+    }
+
+    const int k = static_cast<int>(std::lower_bound(slabY.constBegin(), slabY.constEnd(), p.y())
+                                   - slabY.constBegin());
+    if (k == 0 || k == slabY.size())
+    {
+        return false;// Above or below of all edges
+    }
+
+    int low = slabStart.at(k-1);
+    int high = slabStart.at(k);
+    if (slabCrossed.at(k-1))
+    {
+        int count = 0;
+        for (int i = low; i < high; ++i)
+        {
+            if (slabEdges.at(i).X(p.y()) < p.x())
+            {
+                ++count;
+            }
+        }
+        return (count & 1) == 1;
+    }
+
+    // Count edges left from the point. They are sorted by x inside the slab.
+    const int first = low;
+    while (low < high)
+    {
+        const int middle = low + (high - low)/2;
+        if (slabEdges.at(middle).X(p.y()) < p.x())
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return ((low - first) & 1) == 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSpatialIndex::BuildSlabs(const VContour &contour)
+{
+    polygonEdges.clear();
+    slabY.clear();
+    slabStart.clear();
+    slabEdges.clear();
+    slabCrossed.clear();
+
+    // Final check of position must use exact region, not simplified global contour.
+    const QVector<QPointF> polygon = contour.GetExactContour();
+    const int n = polygon.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    polygonEdges.reserve(n);
+    slabY.reserve(n);
+
+    int j = n-1;
+    for (int i = 0; i < n; ++i)
+    {
+        const qreal xi = polygon.at(i).x();
+        const qreal xj = polygon.at(j).x();
+        const qreal yi = polygon.at(i).y();
+        const qreal yj = polygon.at(j).y();
+
+        VSlabEdge edge;
+        if (qFuzzyCompare(yj, yi) == false)
+        {
+            edge.constant = xi - (yi*xj)/(yj-yi) + (yi*xi)/(yj-yi);
+            edge.multiple = (xj-xi)/(yj-yi);
+        }
+        else
+        {
+            edge.constant = xi;
+        }
+        edge.minY = qMin(yi, yj);
+        edge.maxY = qMax(yi, yj);
+        polygonEdges.append(edge);
+        slabY.append(yi);
+
+        j = i;
+    }
+
+    std::sort(slabY.begin(), slabY.end());
+    slabY.erase(std::unique(slabY.begin(), slabY.end()), slabY.end());
+
+    const int slabs = slabY.size() - 1;
+    if (slabs <= 0)
+    {
+        return;
+    }
+
+    // Edge covers slabs from first to last - 1.
+    QVector<int> first(polygonEdges.size());
+    QVector<int> last(polygonEdges.size());
+    QVector<int> counts(slabs + 1, 0);
+    qint64 total = 0;
+    for (int i = 0; i < polygonEdges.size(); ++i)
+    {
+        const VSlabEdge &edge = polygonEdges.at(i);
+        first[i] = static_cast<int>(std::lower_bound(slabY.constBegin(), slabY.constEnd(), edge.minY)
+                                    - slabY.constBegin());
+        last[i] = static_cast<int>(std::lower_bound(slabY.constBegin(), slabY.constEnd(), edge.maxY)
+                                   - slabY.constBegin());
+        for (int s = first.at(i); s < last.at(i); ++s)
+        {
+            ++counts[s+1];
+        }
+        total += last.at(i) - first.at(i);
+    }
+
+    if (total > maxSlabEdges)
+    {
+        return;// Too big, InsidePolygon() will use polygonEdges
+    }
+
+    for (int s = 1; s <= slabs; ++s)
+    {
+        counts[s] += counts.at(s-1);
+    }
+    slabStart = counts;
+
+    slabEdges.resize(static_cast<int>(total));
+    QVector<int> filled = slabStart;
+    for (int i = 0; i < polygonEdges.size(); ++i)
+    {
+        for (int s = first.at(i); s < last.at(i); ++s)
+        {
+            slabEdges[filled[s]++] = polygonEdges.at(i);
+        }
+    }
+
+    slabCrossed.fill(false, slabs);
+    for (int s = 0; s < slabs; ++s)
+    {
+        const qreal y = (slabY.at(s) + slabY.at(s+1))/2;
+        std::sort(slabEdges.begin() + slabStart.at(s), slabEdges.begin() + slabStart.at(s+1),
+                  [y](const VSlabEdge &a, const VSlabEdge &b) {return a.X(y) < b.X(y);});
+
+        // Order must be the same on both borders, otherwise edges cross each other.
+        for (int i = slabStart.at(s) + 1; i < slabStart.at(s+1); ++i)
+        {
+            if (slabEdges.at(i).X(slabY.at(s)) < slabEdges.at(i-1).X(slabY.at(s)) - slabTolerance ||
+                slabEdges.at(i).X(slabY.at(s+1)) < slabEdges.at(i-1).X(slabY.at(s+1)) - slabTolerance)
+            {
+                slabCrossed[s] = true;
+                break;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSpatialIndex::Query(qreal x1, qreal y1, qreal x2, qreal y2, QVector<int> &result) const
+{
+    result.clear();
+
+    if (columns == 0 || rows == 0)
+    {
+        return;
+    }
+
+    x1 -= indexTolerance;
+    x2 += indexTolerance;
+    y1 -= indexTolerance;
+    y2 += indexTolerance;
+
+    if (x2 < left || y2 < top || x1 > left + columns*cellSize || y1 > top + rows*cellSize)
+    {
+        return;// Outside of the contour
+    }
+
+    const int c1 = Column(x1);
+    const int c2 = Column(x2);
+    const int r1 = Row(y1);
+    const int r2 = Row(y2);
+
+    for (int r = r1; r <= r2; ++r)
+    {
+        for (int c = c1; c <= c2; ++c)
+        {
+            const QVector<int> &cell = cells.at(r*columns + c);
+            for (int k = 0; k < cell.size(); ++k)
+            {
+                // Cell is only an approximation, compare with bounding rectangle of the edge itself.
+                const QLineF &edge = edges.at(cell.at(k)-1);
+                if (qMax(edge.x1(), edge.x2()) >= x1 && qMin(edge.x1(), edge.x2()) <= x2 &&
+                    qMax(edge.y1(), edge.y2()) >= y1 && qMin(edge.y1(), edge.y2()) <= y2)
+                {
+                    result.append(cell.at(k));
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSpatialIndex::Column(qreal x) const
+{
+    return qBound(0, qFloor((x - left)/cellSize), columns-1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSpatialIndex::Row(qreal y) const
+{
+    return qBound(0, qFloor((y - top)/cellSize), rows-1);
+}
@@ -0,0 +1,122 @@
+/************************************************************************
+ **
+ **  @file   vspatialindex.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef VSPATIALINDEX_H
+#define VSPATIALINDEX_H
+
+#include <QVector>
+#include <QLineF>
+
+class VContour;
+class QRectF;
+class QPointF;
+
+/**
+ * @brief The VSlabEdge struct edge of polygon prepared for ray casting.
+ */
+struct VSlabEdge
+{
+    VSlabEdge()
+        :constant(0), multiple(0), minY(0), maxY(0)
+    {}
+
+    qreal constant;
+    qreal multiple;
+    qreal minY;
+    qreal maxY;
+
+    inline qreal X(qreal y) const
+    {
+        return y*multiple + constant;
+    }
+};
+
+/**
+ * @brief The VSpatialIndex class uniform grid over edges of global contour.
+ *
+ * Index is built once for each state of global contour and after that used only for reading. That's why one object
+ * can be shared between all threads that check positions of a detail.
+ *
+ * For point in polygon test the index also keeps slab decomposition of the contour. Slab is a horizontal band between
+ * two neighbour y coordinates of points. Inside a slab edges don't cross each other, so they can be sorted by x and
+ * a ray casting needs only two binary searches. If global contour crosses itself, such slabs are checked edge by edge.
+ */
+class VSpatialIndex
+{
+public:
+    VSpatialIndex();
+    explicit VSpatialIndex(const VContour &contour);
+
+    void Build(const VContour &contour);
+    void Build(const QVector<QLineF> &lines);
+
+    int           EdgesCount() const;
+    const QLineF &Edge(int i) const;
+    bool          HasNullEdge() const;
+
+    void Candidates(const QLineF &line, QVector<int> &result) const;
+    void Candidates(const QRectF &rect, QVector<int> &result) const;
+
+    bool InsidePolygon(const QPointF &p) const;
+
+private:
+    /** @brief edges cached edges of global contour. Index in vector = number of edge - 1. */
+    QVector<QLineF> edges;
+
+    /** @brief cells for each cell list of edge numbers which bounding rectangles touch it. */
+    QVector<QVector<int> > cells;
+
+    qreal left;
+    qreal top;
+    qreal cellSize;
+    int   columns;
+    int   rows;
+    bool  nullEdge;
+
+    /** @brief polygonEdges closed exact polygon of global contour. Line x = y*multiple + constant for each edge. */
+    QVector<VSlabEdge> polygonEdges;
+
+    /** @brief slabY sorted unique y coordinates of contour points. Slab i is (slabY[i], slabY[i+1]]. */
+    QVector<qreal> slabY;
+
+    /** @brief slabStart offsets of slabs in slabEdges. Empty if decomposition was too big. */
+    QVector<int> slabStart;
+
+    /** @brief slabEdges edges crossing each slab, sorted by x inside a slab. */
+    QVector<VSlabEdge> slabEdges;
+
+    /** @brief slabCrossed true if edges cross each other inside a slab. Such slab can't use binary search. */
+    QVector<bool> slabCrossed;
+
+    int Column(qreal x) const;
+    int Row(qreal y) const;
+
+    void Query(qreal x1, qreal y1, qreal x2, qreal y2, QVector<int> &result) const;
+    void BuildGrid(const QVector<QLineF> &lines);
+    void BuildSlabs(const VContour &contour);
+};
+
+#endif // VSPATIALINDEX_H
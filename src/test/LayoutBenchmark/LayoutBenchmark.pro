@@ -0,0 +1,92 @@
+# Build layout benchmark. Arranges details from a text fixture and prints timings and counters.
+
+# File with common stuff for whole project
+include(../../../Valentina.pri)
+
+# Layout library uses QPainterPath and QGraphicsItem.
+QT       += core gui widgets
+
+# Name of binary file.
+TARGET = LayoutBenchmark
+
+# Console application, we use C++11 standard.
+CONFIG   += console c++11
+
+# Use out-of-source builds (shadow builds)
+CONFIG   -= app_bundle debug_and_release debug_and_release_target
+
+# We want create executable file
+TEMPLATE = app
+
+# directory for executable file
+DESTDIR = bin
+
+# objecs files
+OBJECTS_DIR = obj
+
+HEADERS += \
+    stable.h
+
+SOURCES += \
+    main.cpp \
+    stable.cpp
+
+# Set using ccache. Function enable_ccache() defined in Valentina.pri.
+$$enable_ccache()
+
+# Set precompiled headers. Function set_PCH() defined in Valentina.pri.
+$$set_PCH()
+
+CONFIG(debug, debug|release){
+    # Debug mode
+    unix {
+        #Turn on compilers warnings.
+        *-g++{
+        QMAKE_CXXFLAGS += \
+            $$GCC_DEBUG_CXXFLAGS # See Valentina.pri for more details.
+
+        #gcc’s 4.8.0 Address Sanitizer
+        #http://blog.qt.digia.com/blog/2013/04/17/using-gccs-4-8-0-address-sanitizer-with-qt/
+        QMAKE_CFLAGS+=-fsanitize=address -fno-omit-frame-pointer
+        QMAKE_LFLAGS+=-fsanitize=address
+        }
+        clang*{
+        QMAKE_CXXFLAGS += \
+            $$CLANG_DEBUG_CXXFLAGS # See Valentina.pri for more details.
+        }
+    } else {
+        *-g++{
+        QMAKE_CXXFLAGS += $$GCC_DEBUG_CXXFLAGS # See Valentina.pri for more details.
+        }
+    }
+
+}else{
+    # Release mode
+    DEFINES += QT_NO_DEBUG_OUTPUT
+
+    # Turn on debug symbols in release mode on Unix systems.
+    # On Mac OS X temporarily disabled. Need find way how to strip binary file.
+    unix:!macx:QMAKE_CXXFLAGS_RELEASE += -g -gdwarf-3
+}
+
+# Make possible run benchmark without arguments. Seek fixtures in local directory.
+copyToDestdir($${PWD}/fixtures/shirt.txt, $$shell_path($${OUT_PWD}/$$DESTDIR/fixtures))
+
+#VLayout static library
+unix|win32: LIBS += -L$$OUT_PWD/../../libs/vlayout/bin/ -lvlayout
+
+INCLUDEPATH += $$PWD/../../libs/vlayout
+DEPENDPATH += $$PWD/../../libs/vlayout
+
+win32:!win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vlayout/bin/vlayout.lib
+else:unix|win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vlayout/bin/libvlayout.a
+
+# Strip after you link all libaries.
+CONFIG(release, debug|release){
+    unix:!macx{
+        # Strip debug symbols.
+        QMAKE_POST_LINK += objcopy --only-keep-debug $(TARGET) $(TARGET).debug &&
+        QMAKE_POST_LINK += strip --strip-debug --strip-unneeded $(TARGET) &&
+        QMAKE_POST_LINK += objcopy --add-gnu-debuglink $(TARGET).debug $(TARGET)
+    }
+}
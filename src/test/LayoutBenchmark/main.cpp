@@ -0,0 +1,256 @@
+/************************************************************************
+ **
+ **  @file   main.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QPointF>
+#include <QVector>
+#include <cstdio>
+
+#include "vlayoutgenerator.h"
+#include "vlayoutdetail.h"
+#include "vlayoutstatistics.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ReadDetails read fixture. Each not empty line that doesn't start with '#' is a detail. Points "x,y" are
+ * separated by spaces.
+ */
+bool ReadDetails(const QString &fileName, QVector<VLayoutDetail> &details)
+{
+    QFile file(fileName);
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+    {
+        fprintf(stderr, "Can't open fixture %s.\n", qPrintable(fileName));
+        return false;
+    }
+
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (in.atEnd() == false)
+    {
+        const QString line = in.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+        {
+            continue;
+        }
+
+        QVector<QPointF> points;
+        const QStringList pairs = line.split(QLatin1Char(' '), QString::SkipEmptyParts);
+        for (int i = 0; i < pairs.size(); ++i)
+        {
+            const QStringList xy = pairs.at(i).split(QLatin1Char(','));
+            bool okX = false;
+            bool okY = false;
+            const qreal x = xy.size() == 2 ? xy.at(0).toDouble(&okX) : 0;
+            const qreal y = xy.size() == 2 ? xy.at(1).toDouble(&okY) : 0;
+            if (okX == false || okY == false)
+            {
+                fprintf(stderr, "%s:%d: wrong point '%s'.\n", qPrintable(fileName), lineNumber,
+                        qPrintable(pairs.at(i)));
+                return false;
+            }
+            points.append(QPointF(x, y));
+        }
+
+        if (points.size() < 3)
+        {
+            fprintf(stderr, "%s:%d: detail needs at least 3 points.\n", qPrintable(fileName), lineNumber);
+            return false;
+        }
+
+        VLayoutDetail detail;
+        detail.SetCountourPoints(points);
+        detail.SetSeamAllowencePoints(points);
+        details.append(detail);
+    }
+
+    return details.isEmpty() == false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString ErrorText(LayoutErrors state)
+{
+    switch (state)
+    {
+        case LayoutErrors::NoError:
+            return QStringLiteral("no error");
+        case LayoutErrors::PrepareLayoutError:
+            return QStringLiteral("couldn't prepare data for creation layout");
+        case LayoutErrors::PaperSizeError:
+            return QStringLiteral("wrong paper size");
+        case LayoutErrors::ProcessStoped:
+            return QStringLiteral("process stopped");
+        case LayoutErrors::EmptyPaperError:
+            return QStringLiteral("couldn't place a detail on empty sheet");
+        case LayoutErrors::TerminatedByException:
+            return QStringLiteral("terminated by exception");
+        default:
+            return QStringLiteral("unknown error");
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("LayoutBenchmark"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Arrange details from a fixture and print timings of layout."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("fixture"), QStringLiteral("File with details."));
+
+    const QCommandLineOption widthOption(QStringList() << "w" << "width", "Paper width in pixels.", "px", "1500");
+    const QCommandLineOption heightOption(QStringList() << "e" << "height", "Paper height in pixels.", "px", "4000");
+    const QCommandLineOption layoutOption(QStringList() << "l" << "layout-width", "Layout width in pixels.", "px",
+                                          "10");
+    const QCommandLineOption shiftOption(QStringList() << "s" << "shift", "Shift length in pixels.", "px", "50");
+    const QCommandLineOption increaseOption(QStringList() << "i" << "increase", "Rotation increase in degrees.",
+                                            "degrees", "180");
+    const QCommandLineOption noRotateOption(QStringList() << "n" << "no-rotate", "Don't rotate details.");
+    const QCommandLineOption caseOption(QStringList() << "c" << "case",
+                                        "Principle of choosing the next workpiece: three, two or desc.", "case",
+                                        "three");
+    const QCommandLineOption rollOption(QStringList() << "o" << "roll", "Arrange on roll. Paper height is ignored.");
+    const QCommandLineOption nfpOption(QStringList() << "f" << "nfp", "Place details by no-fit polygons.");
+    const QCommandLineOption parallelOption(QStringList() << "p" << "parallel", "Run several variants of layout.");
+    const QCommandLineOption optimizeOption(QStringList() << "t" << "optimize",
+                                            "Search better order of details during this time.", "seconds", "0");
+    const QCommandLineOption seedOption(QStringList() << "d" << "seed",
+                                        "Seed for reproducible layout. 0 keeps order of details.", "seed", "0");
+    const QCommandLineOption resultOption(QStringList() << "a" << "result", "Save result of the last run to file.",
+                                          "file");
+    const QCommandLineOption repeatOption(QStringList() << "r" << "repeat", "How many times run layout.", "count",
+                                          "1");
+
+    parser.addOption(widthOption);
+    parser.addOption(heightOption);
+    parser.addOption(layoutOption);
+    parser.addOption(shiftOption);
+    parser.addOption(increaseOption);
+    parser.addOption(noRotateOption);
+    parser.addOption(caseOption);
+    parser.addOption(rollOption);
+    parser.addOption(nfpOption);
+    parser.addOption(parallelOption);
+    parser.addOption(optimizeOption);
+    parser.addOption(seedOption);
+    parser.addOption(resultOption);
+    parser.addOption(repeatOption);
+    parser.process(app);
+
+    QString fixture = QCoreApplication::applicationDirPath() + QStringLiteral("/fixtures/shirt.txt");
+    if (parser.positionalArguments().isEmpty() == false)
+    {
+        fixture = parser.positionalArguments().first();
+    }
+
+    QVector<VLayoutDetail> details;
+    if (ReadDetails(fixture, details) == false)
+    {
+        return 1;
+    }
+
+    Cases caseType = Cases::CaseThreeGroup;
+    const QString caseName = parser.value(caseOption);
+    if (caseName == QLatin1String("two"))
+    {
+        caseType = Cases::CaseTwoGroup;
+    }
+    else if (caseName == QLatin1String("desc"))
+    {
+        caseType = Cases::CaseDesc;
+    }
+
+    const int repeat = qMax(1, parser.value(repeatOption).toInt());
+
+    VLayoutGenerator generator;
+    generator.SetDetails(details);
+    generator.SetLayoutWidth(parser.value(layoutOption).toDouble());
+    generator.SetCaseType(caseType);
+    generator.SetPaperWidth(parser.value(widthOption).toInt());
+    generator.SetPaperHeight(parser.value(heightOption).toInt());
+    generator.SetRoll(parser.isSet(rollOption));
+    generator.SetPlacement(parser.isSet(nfpOption) ? Placement::NoFitPolygon : Placement::CombineEdges);
+    generator.SetShift(parser.value(shiftOption).toUInt());
+    generator.SetRotate(parser.isSet(noRotateOption) == false);
+    generator.SetRotationIncrease(parser.value(increaseOption).toInt());
+    generator.SetParallelVariants(parser.isSet(parallelOption));
+    generator.SetOptimizationTime(parser.value(optimizeOption).toInt());
+    generator.SetSeed(parser.value(seedOption).toUInt());
+
+    fprintf(stdout, "Fixture: %s, details: %d\n", qPrintable(fixture), details.size());
+
+    qint64 total = 0;
+    for (int i = 0; i < repeat; ++i)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        generator.Generate();
+        const qint64 elapsed = timer.elapsed();
+        total += elapsed;
+
+        if (generator.State() != LayoutErrors::NoError)
+        {
+            fprintf(stderr, "Layout failed: %s.\n", qPrintable(ErrorText(generator.State())));
+            return 1;
+        }
+
+        const VLayoutStatistics statistics = generator.GetStatistics();
+        fprintf(stdout, "Run %d: %lld ms\n", i+1, elapsed);
+        fprintf(stdout, "  sheets:               %d\n", generator.PapersCount());
+        fprintf(stdout, "  marker length:        %d px\n", generator.MarkerLength());
+        fprintf(stdout, "  utilisation:          %.2f%%\n", generator.Utilisation());
+        fprintf(stdout, "  positions:            %lld\n", statistics.positions);
+        fprintf(stdout, "  outside of sheet:     %lld\n", statistics.outsideSheet);
+        fprintf(stdout, "  bounding box cleared: %lld\n", statistics.boundingBoxCleared);
+        fprintf(stdout, "  convex hull cleared:  %lld\n", statistics.hullCleared);
+        fprintf(stdout, "  exact edges checked:  %lld\n", statistics.edgesChecked);
+        fprintf(stdout, "  intersections:        %lld\n", statistics.intersections);
+        fprintf(stdout, "  inside contour:       %lld\n", statistics.inside);
+        fprintf(stdout, "  accepted:             %lld\n", statistics.accepted);
+        if (elapsed > 0)
+        {
+            fprintf(stdout, "  positions per second: %lld\n", statistics.positions*1000/elapsed);
+        }
+    }
+
+    fprintf(stdout, "Average: %lld ms\n", total/repeat);
+
+    if (parser.isSet(resultOption) && generator.WriteResult(parser.value(resultOption)) == false)
+    {
+        fprintf(stderr, "Can't save result to %s.\n", qPrintable(parser.value(resultOption)));
+        return 1;
+    }
+
+    return 0;
+}
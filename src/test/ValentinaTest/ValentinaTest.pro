@@ -0,0 +1,157 @@
+# Build unit tests of Valentina and its libraries. Uses QTestLib.
+
+# File with common stuff for whole project
+include(../../../Valentina.pri)
+
+# Tests check code of the application, so we need the same modules.
+QT       += core gui widgets xml svg printsupport xmlpatterns testlib
+
+# Name of binary file.
+TARGET = ValentinaTest
+
+# Console application, we use C++11 standard.
+CONFIG   += console c++11
+
+# Use out-of-source builds (shadow builds)
+CONFIG   -= app_bundle debug_and_release debug_and_release_target
+
+# We want create executable file
+TEMPLATE = app
+
+# Since Qt 5.4.0 the source code location is recorded only in debug builds.
+# We need this information also in release builds. For this need define QT_MESSAGELOGCONTEXT.
+DEFINES += QT_MESSAGELOGCONTEXT
+
+# directory for executable file
+DESTDIR = bin
+
+# Directory for files created moc
+MOC_DIR = moc
+
+# objecs files
+OBJECTS_DIR = obj
+
+# Directory for files created uic
+UI_DIR = uic
+
+# Tested classes of the application. Application doesn't have a library, so we build its sources once more without
+# main().
+include(../../app/app.pri)
+SOURCES -= $$clean_path($${PWD}/../../app/main.cpp)
+
+# This include path help promoute VMainGraphicsView on main window. Without it compiler can't find path to custom view
+INCLUDEPATH += "$${PWD}/../../app/widgets"
+
+HEADERS += \
+    stable.h \
+    tst_vspatialindex.h \
+    tst_vlayoutdetail.h \
+    tst_vcontour.h \
+    tst_vabstractdetail.h \
+    tst_vspline.h \
+    tst_qmuparserbytecode.h \
+    tst_vdependencygraph.h \
+    tst_calculator.h
+
+SOURCES += \
+    main.cpp \
+    stable.cpp \
+    tst_vspatialindex.cpp \
+    tst_vlayoutdetail.cpp \
+    tst_vcontour.cpp \
+    tst_vabstractdetail.cpp \
+    tst_vspline.cpp \
+    tst_qmuparserbytecode.cpp \
+    tst_vdependencygraph.cpp \
+    tst_calculator.cpp
+
+# Set using ccache. Function enable_ccache() defined in Valentina.pri.
+$$enable_ccache()
+
+# Set precompiled headers. Function set_PCH() defined in Valentina.pri.
+$$set_PCH()
+
+CONFIG(debug, debug|release){
+    # Debug mode
+    unix {
+        #Turn on compilers warnings.
+        *-g++{
+        QMAKE_CXXFLAGS += \
+            # Key -isystem disable checking errors in system headers.
+            -isystem "$${OUT_PWD}/$${UI_DIR}" \
+            -isystem "$${OUT_PWD}/$${MOC_DIR}" \
+            $$GCC_DEBUG_CXXFLAGS # See Valentina.pri for more details.
+
+        #gcc’s 4.8.0 Address Sanitizer
+        #http://blog.qt.digia.com/blog/2013/04/17/using-gccs-4-8-0-address-sanitizer-with-qt/
+        QMAKE_CFLAGS+=-fsanitize=address -fno-omit-frame-pointer
+        QMAKE_LFLAGS+=-fsanitize=address
+        }
+        clang*{
+        QMAKE_CXXFLAGS += \
+            # Key -isystem disable checking errors in system headers.
+            -isystem "$${OUT_PWD}/$${UI_DIR}" \
+            -isystem "$${OUT_PWD}/$${MOC_DIR}" \
+            $$CLANG_DEBUG_CXXFLAGS # See Valentina.pri for more details.
+        }
+    } else {
+        *-g++{
+        QMAKE_CXXFLAGS += $$GCC_DEBUG_CXXFLAGS # See Valentina.pri for more details.
+        }
+    }
+
+    DEFINES += "LATEST_TAG_DISTANCE=0"
+    DEFINES += "BUILD_REVISION=\\\"unknown\\\""
+}else{
+    # Release mode
+    DEFINES += V_NO_ASSERT
+    DEFINES += "LATEST_TAG_DISTANCE=0"
+    DEFINES += "BUILD_REVISION=\\\"unknown\\\""
+
+    # Turn on debug symbols in release mode on Unix systems.
+    # On Mac OS X temporarily disabled. Need find way how to strip binary file.
+    unix:!macx:QMAKE_CXXFLAGS_RELEASE += -g -gdwarf-3
+}
+
+# QMuParser library
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../../libs/qmuparser/bin/ -lqmuparser2
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../../libs/qmuparser/bin/ -lqmuparser2
+else:unix: LIBS += -L$$OUT_PWD/../../libs/qmuparser/bin/ -lqmuparser
+
+INCLUDEPATH += $$PWD/../../libs/qmuparser
+DEPENDPATH += $$PWD/../../libs/qmuparser
+
+# VPropertyExplorer library
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../../libs/vpropertyexplorer/bin/ -lvpropertyexplorer
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../../libs/vpropertyexplorer/bin/ -lvpropertyexplorer
+else:unix: LIBS += -L$$OUT_PWD/../../libs/vpropertyexplorer/bin/ -lvpropertyexplorer
+
+INCLUDEPATH += $$PWD/../../libs/vpropertyexplorer
+DEPENDPATH += $$PWD/../../libs/vpropertyexplorer
+
+# IFC static library
+unix|win32: LIBS += -L$$OUT_PWD/../../libs/ifc/bin/ -lifc
+
+INCLUDEPATH += $$PWD/../../libs/ifc
+DEPENDPATH += $$PWD/../../libs/ifc
+
+win32:!win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/ifc/bin/ifc.lib
+else:unix|win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/ifc/bin/libifc.a
+
+# VObj static library
+unix|win32: LIBS += -L$$OUT_PWD/../../libs/vobj/bin/ -lvobj
+
+INCLUDEPATH += $$PWD/../../libs/vobj
+DEPENDPATH += $$PWD/../../libs/vobj
+
+win32:!win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vobj/bin/vobj.lib
+else:unix|win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vobj/bin/libvobj.a
+
+#VLayout static library
+unix|win32: LIBS += -L$$OUT_PWD/../../libs/vlayout/bin/ -lvlayout
+
+INCLUDEPATH += $$PWD/../../libs/vlayout
+DEPENDPATH += $$PWD/../../libs/vlayout
+
+win32:!win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vlayout/bin/vlayout.lib
+else:unix|win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vlayout/bin/libvlayout.a
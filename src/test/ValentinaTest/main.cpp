@@ -0,0 +1,62 @@
+/************************************************************************
+ **
+ **  @file   main.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vspatialindex.h"
+#include "tst_vlayoutdetail.h"
+#include "tst_vcontour.h"
+#include "tst_vabstractdetail.h"
+#include "tst_vspline.h"
+#include "tst_qmuparserbytecode.h"
+#include "tst_vdependencygraph.h"
+#include "tst_calculator.h"
+#include "../../app/core/vapplication.h"
+
+#include <QtTest>
+
+//---------------------------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Tested classes convert units through qApp. Without display run tests with "-platform offscreen".
+    VApplication app(argc, argv);
+
+    int status = 0;
+    auto ASSERT_TEST = [&status, argc, argv](QObject *obj)
+    {
+        status |= QTest::qExec(obj, argc, argv);
+        delete obj;
+    };
+
+    ASSERT_TEST(new TST_VSpatialIndex());
+    ASSERT_TEST(new TST_VLayoutDetail());
+    ASSERT_TEST(new TST_VContour());
+    ASSERT_TEST(new TST_VAbstractDetail());
+    ASSERT_TEST(new TST_VSpline());
+    ASSERT_TEST(new TST_QmuParserByteCode());
+    ASSERT_TEST(new TST_VDependencyGraph());
+    ASSERT_TEST(new TST_Calculator());
+
+    return status;
+}
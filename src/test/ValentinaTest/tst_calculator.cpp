@@ -0,0 +1,128 @@
+/************************************************************************
+ **
+ **  @file   tst_calculator.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_calculator.h"
+#include "../../app/container/calculator.h"
+#include "../../app/container/vcontainer.h"
+#include "../../app/core/vapplication.h"
+#include "../../app/geometry/vpointf.h"
+
+#include <QtTest>
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_Calculator::TST_Calculator(QObject *parent)
+    :QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Calculator::initTestCase()
+{
+    qApp->setPatternUnit(Unit::Cm);
+    qApp->setPatternType(MeasurementsType::Standard);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Calculator::cleanupTestCase()
+{
+    qApp->setPatternType(MeasurementsType::Individual);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Calculator::GradedBulk_data() const
+{
+    QTest::addColumn<QString>("formula");
+
+    QTest::newRow("Number") << QString("10.5");
+    QTest::newRow("Size and height") << QString("size*0.5+height/10");
+    QTest::newRow("Measurements") << QString("neck_girth+bust_girth*2");
+    QTest::newRow("Increment") << QString("(bust_girth-Inc_1)*size/height");
+    QTest::newRow("Functions") << QString("sqrt(bust_girth)+sin(neck_girth)-abs(Inc_1)");
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GradedBulk Calculator::EvalFormulaBulk() must give the same values as recalculation for each size and height.
+ */
+void TST_Calculator::GradedBulk() const
+{
+    QFETCH(QString, formula);
+
+    VContainer data;
+    data.SetSizeName(size_M);
+    data.SetHeightName(height_M);
+    data.AddVariable("neck_girth", new VMeasurement("neck_girth", 36.6, 1.2, 0.3));
+    data.AddVariable("bust_girth", new VMeasurement("bust_girth", 100, 4, 0.5));
+    data.AddVariable("Inc_1", new VIncrement("Inc_1", 0, 2.5, 0.2, -0.1));
+
+    QVector<qreal> sizes;
+    for (int size = 36; size <= 56; size += 2)
+    {
+        sizes.append(size);
+    }
+
+    QVector<qreal> heights;
+    for (int height = 152; height <= 188; height += 6)
+    {
+        heights.append(height);
+    }
+
+    QVector<qreal> results;
+    QVERIFY(Calculator::EvalFormulaBulk(&data, formula, sizes, heights, results));
+    QCOMPARE(results.size(), sizes.size() * heights.size());
+
+    for (int h = 0; h < heights.size(); ++h)
+    {
+        for (int s = 0; s < sizes.size(); ++s)
+        {
+            VContainer::SetSize(sizes.at(s));
+            VContainer::SetHeight(heights.at(h));
+            const qreal expected = Calculator::EvalFormula(&data, formula);
+            QCOMPARE(results.at(h * sizes.size() + s), expected);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GeometryFormula length of line depends on geometry of each size, bulk evaluation must refuse it.
+ */
+void TST_Calculator::GeometryFormula() const
+{
+    VContainer data;
+    data.SetSizeName(size_M);
+    data.SetHeightName(height_M);
+    data.AddVariable("bust_girth", new VMeasurement("bust_girth", 100, 4, 0.5));
+
+    const VPointF p1(QPointF(0, 0), "A", 0, 0);
+    const VPointF p2(QPointF(100, 0), "B", 0, 0);
+    VLengthLine *line = new VLengthLine(&p1, 1, &p2, 2);
+    const QString name = line->GetName();
+    data.AddVariable(name, line);
+
+    QVector<qreal> results;
+    QVERIFY(Calculator::EvalFormulaBulk(&data, "bust_girth+" + name, QVector<qreal>() << 50 << 52,
+                                        QVector<qreal>() << 176, results) == false);
+}
@@ -0,0 +1,130 @@
+/************************************************************************
+ **
+ **  @file   tst_qmuparserbytecode.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_qmuparserbytecode.h"
+#include "../../libs/qmuparser/qmuparser.h"
+
+#include <QtTest>
+
+using namespace qmu;
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_QmuParserByteCode::TST_QmuParserByteCode(QObject *parent)
+    :QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_QmuParserByteCode::RebindVars_data() const
+{
+    QTest::addColumn<QString>("formula");
+
+    QTest::newRow("Sum") << QString("a+b");
+    QTest::newRow("Same variable twice") << QString("a*b+a");
+    QTest::newRow("Power") << QString("a^2+b^3");
+    QTest::newRow("Functions") << QString("sin(a)*b-a/b");
+    QTest::newRow("Brackets") << QString("(a+b)*(a-b)+c");
+    QTest::newRow("Only numbers") << QString("2*3+1");
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RebindVars bytecode compiled by one parser must give the same result in other parser after its pointers
+ * were replaced by pointers to variables of that parser.
+ */
+void TST_QmuParserByteCode::RebindVars() const
+{
+    QFETCH(QString, formula);
+
+    qreal a1 = 2, b1 = 3, c1 = 4;
+    QmuParser first;
+    first.DefineVar("a", &a1);
+    first.DefineVar("b", &b1);
+    first.DefineVar("c", &c1);
+    first.SetExpr(formula);
+    first.Eval();// Parse formula and create bytecode
+
+    qreal a2 = 5, b2 = 7, c2 = 11;
+    QmuParserByteCode byteCode = first.GetByteCode();
+    QVector<qreal*> vars = byteCode.GetVars();
+    for (int i = 0; i < vars.size(); ++i)
+    {
+        if (vars.at(i) == &a1)
+        {
+            vars[i] = &a2;
+        }
+        else if (vars.at(i) == &b1)
+        {
+            vars[i] = &b2;
+        }
+        else if (vars.at(i) == &c1)
+        {
+            vars[i] = &c2;
+        }
+        else
+        {
+            QFAIL("Bytecode points to unknown variable.");
+        }
+    }
+    QVERIFY(byteCode.SetVars(vars));
+
+    QmuParser second;
+    second.DefineVar("a", &a2);
+    second.DefineVar("b", &b2);
+    second.DefineVar("c", &c2);
+    second.SetExpr(formula);
+    second.SetByteCode(byteCode, first.GetNumResults());
+
+    QmuParser expected;
+    expected.DefineVar("a", &a2);
+    expected.DefineVar("b", &b2);
+    expected.DefineVar("c", &c2);
+    expected.SetExpr(formula);
+
+    QCOMPARE(second.Eval(), expected.Eval());
+
+    // Bytecode must follow values of new variables.
+    a2 = 13;
+    QCOMPARE(second.Eval(), expected.Eval());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_QmuParserByteCode::WrongCountOfVars() const
+{
+    qreal a = 2, b = 3;
+    QmuParser parser;
+    parser.DefineVar("a", &a);
+    parser.DefineVar("b", &b);
+    parser.SetExpr("a*b");
+    parser.Eval();
+
+    QmuParserByteCode byteCode = parser.GetByteCode();
+    const QVector<qreal*> vars = byteCode.GetVars();
+    QCOMPARE(vars.size(), 2);
+
+    qreal c = 4;
+    QVERIFY(byteCode.SetVars(QVector<qreal*>() << &c) == false);
+    QCOMPARE(byteCode.GetVars(), vars);
+}
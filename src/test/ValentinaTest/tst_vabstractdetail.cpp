@@ -0,0 +1,206 @@
+/************************************************************************
+ **
+ **  @file   tst_vabstractdetail.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vabstractdetail.h"
+#include "../../libs/vlayout/vabstractdetail.h"
+
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief OldRemoveDublicates quadratic search of duplicates as it was before hash of grid cells.
+ */
+QVector<QPointF> OldRemoveDublicates(const QVector<QPointF> &points)
+{
+    QVector<QPointF> p = points;
+    for (int i = 0; i < p.size(); i++)
+    {
+        const QPointF current = p.at(i);
+        for (int j = i+1; j < p.size(); j++)
+        {
+            if (current == p.at(j))
+            {
+                p.remove(j);
+                j--;
+            }
+        }
+    }
+    return p;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief OldCheckLoops quadratic search of loops as it was before sweep over bounding rectangles.
+ */
+QVector<QPointF> OldCheckLoops(const QVector<QPointF> &points)
+{
+    QVector<QPointF> ekvPoints;
+    if (points.size() < 4)
+    {
+        return points;
+    }
+    const bool closed = points.at(0) == points.at(points.size()-1);
+    qint32 i, j;
+    for (i = 0; i < points.size(); ++i)
+    {
+        if (i >= points.size()-3)
+        {
+            ekvPoints.append(points.at(i));
+            continue;
+        }
+        QPointF crosPoint;
+        QLineF::IntersectType intersect = QLineF::NoIntersection;
+        QLineF line1(points.at(i), points.at(i+1));
+        for (j = i+2; j < points.size()-1; ++j)
+        {
+            QLineF line2(points.at(j), points.at(j+1));
+            intersect = line1.intersect(line2, &crosPoint);
+            if (intersect == QLineF::BoundedIntersection)
+            {
+                break;
+            }
+        }
+        if (intersect == QLineF::BoundedIntersection)
+        {
+            if (i == 0 && j+1 == points.size()-1 && closed)
+            {
+                ekvPoints.append(points.at(i));
+            }
+            else
+            {
+                ekvPoints.append(points.at(i));
+                ekvPoints.append(crosPoint);
+                i = j;
+            }
+        }
+        else
+        {
+            ekvPoints.append(points.at(i));
+        }
+    }
+    return ekvPoints;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VAbstractDetail::TST_VAbstractDetail(QObject *parent)
+    :QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RemoveDublicates hash of grid cells must find the same duplicates as comparing of every pair, also for
+ * points that differ by rounding error and lie in neighbour cells.
+ */
+void TST_VAbstractDetail::RemoveDublicates() const
+{
+    qsrand(1);
+    QVector<QPointF> points;
+    for (int i = 0; i < 3000; ++i)
+    {
+        const int variant = qrand() % 4;
+        if (variant == 0 && points.isEmpty() == false)
+        {
+            points.append(points.at(qrand() % points.size()));
+        }
+        else if (variant == 1 && points.isEmpty() == false)
+        {
+            const QPointF p = points.at(qrand() % points.size());
+            points.append(QPointF(p.x() + 4e-13, p.y() - 4e-13));
+        }
+        else if (variant == 2)
+        {
+            // Exactly on border of cells
+            const qreal x = (qrand() % 100)*0.001;
+            const qreal y = (qrand() % 100)*0.001;
+            points.append(QPointF(x + ((qrand() % 2) ? 4e-13 : -4e-13), y));
+        }
+        else
+        {
+            points.append(QPointF(qrand() % 100, qrand() % 100));
+        }
+    }
+
+    QCOMPARE(VAbstractDetail::RemoveDublicates(points), OldRemoveDublicates(points));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractDetail::CheckLoops_data() const
+{
+    QTest::addColumn<QVector<QPointF>>("points");
+
+    QTest::newRow("Less than four points") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0)
+                                                                  << QPointF(10, 10));
+
+    QTest::newRow("Square") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10)
+                                                   << QPointF(0, 10) << QPointF(0, 0));
+
+    QTest::newRow("Loop") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10)
+                                                 << QPointF(5, -5) << QPointF(0, 10) << QPointF(0, 0));
+
+    QTest::newRow("Two loops") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(20, 0) << QPointF(20, 10)
+                                                      << QPointF(15, -5) << QPointF(10, 10) << QPointF(5, -5)
+                                                      << QPointF(0, 10) << QPointF(0, 0));
+
+    QTest::newRow("Touching segments") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0)
+                                                              << QPointF(10, 10) << QPointF(5, 0)
+                                                              << QPointF(0, 10));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractDetail::CheckLoops() const
+{
+    QFETCH(QVector<QPointF>, points);
+
+    QCOMPARE(VAbstractDetail::CheckLoops(points), OldCheckLoops(points));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CheckLoopsRandom random polylines have many crossings, the sweep must pick the same first crossing.
+ */
+void TST_VAbstractDetail::CheckLoopsRandom() const
+{
+    qsrand(1);
+    for (int test = 0; test < 200; ++test)
+    {
+        QVector<QPointF> points;
+        const int count = 4 + qrand() % 100;
+        for (int i = 0; i < count; ++i)
+        {
+            points.append(QPointF(qrand() % 50, qrand() % 50));
+        }
+
+        if (test % 2 == 0)
+        {
+            points.append(points.first());
+        }
+
+        QCOMPARE(VAbstractDetail::CheckLoops(points), OldCheckLoops(points));
+    }
+}
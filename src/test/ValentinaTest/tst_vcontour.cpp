@@ -0,0 +1,181 @@
+/************************************************************************
+ **
+ **  @file   tst_vcontour.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vcontour.h"
+#include "../../libs/vlayout/vcontour.h"
+
+#include <QtTest>
+#include <QtCore/qmath.h>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+qreal DistanceToContour(const QPointF &p, const QVector<QPointF> &contour)
+{
+    qreal distance = -1;
+    for (int i = 0; i < contour.size(); ++i)
+    {
+        const QPointF &a = contour.at(i);
+        const QPointF &b = contour.at((i + 1) % contour.size());
+        const QLineF segment(a, b);
+        const qreal length2 = segment.dx()*segment.dx() + segment.dy()*segment.dy();
+        qreal t = 0;
+        if (length2 > 0)
+        {
+            t = qBound(0.0, ((p.x() - a.x())*segment.dx() + (p.y() - a.y())*segment.dy())/length2, 1.0);
+        }
+        const qreal d = QLineF(p, segment.pointAt(t)).length();
+        if (distance < 0 || d < distance)
+        {
+            distance = d;
+        }
+    }
+    return distance;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VContour::TST_VContour(QObject *parent)
+    :QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContour::Simplify_data() const
+{
+    QTest::addColumn<QVector<QPointF>>("points");
+    QTest::addColumn<QVector<QPointF>>("expected");
+
+    const QVector<QPointF> square = QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10)
+                                                       << QPointF(0, 10);
+
+    QTest::newRow("Nothing to simplify") << square << square;
+
+    QTest::newRow("Points on edges")
+            << (QVector<QPointF>() << QPointF(0, 0) << QPointF(5, 0) << QPointF(10, 0) << QPointF(10, 5)
+                                   << QPointF(10, 10) << QPointF(5, 10) << QPointF(0, 10) << QPointF(0, 5))
+            << square;
+
+    QTest::newRow("First point on edge")
+            << (QVector<QPointF>() << QPointF(5, 0) << QPointF(10, 0) << QPointF(10, 10) << QPointF(0, 10)
+                                   << QPointF(0, 0))
+            << (QVector<QPointF>() << QPointF(10, 0) << QPointF(10, 10) << QPointF(0, 10) << QPointF(0, 0));
+
+    QTest::newRow("Duplicate points")
+            << (QVector<QPointF>() << QPointF(0, 0) << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10)
+                                   << QPointF(10, 10.0001) << QPointF(0, 10) << QPointF(0, 0))
+            << square;
+
+    QTest::newRow("Spike")
+            << (QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10) << QPointF(5, 10)
+                                   << QPointF(5, 15) << QPointF(5, 10) << QPointF(0, 10))
+            << square;
+
+    QTest::newRow("Spike at first point")
+            << (QVector<QPointF>() << QPointF(5, 15) << QPointF(5, 10) << QPointF(0, 10) << QPointF(0, 0)
+                                   << QPointF(10, 0) << QPointF(10, 10) << QPointF(5, 10))
+            << (QVector<QPointF>() << QPointF(0, 10) << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10));
+
+    QVector<QPointF> longRun;
+    for (int i = 0; i < 1000; ++i)
+    {
+        longRun.append(QPointF(i/100.0, 0));
+    }
+    longRun << QPointF(10, 0) << QPointF(10, 10) << QPointF(0, 10);
+    QTest::newRow("Long collinear run") << longRun << square;
+
+    const QVector<QPointF> notCollinear = QVector<QPointF>() << QPointF(0, 0) << QPointF(5, 0.01) << QPointF(10, 0)
+                                                             << QPointF(10, 10) << QPointF(0, 10);
+    QTest::newRow("Point near edge stays") << notCollinear << notCollinear;
+
+    const QVector<QPointF> line = QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(20, 0);
+    QTest::newRow("Degenerated polygon") << line << line;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContour::Simplify() const
+{
+    QFETCH(QVector<QPointF>, points);
+    QFETCH(QVector<QPointF>, expected);
+
+    QCOMPARE(VContour::Simplify(points), expected);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SimplifyKeepsShape points of a contour cut by shift must stay on simplified contour.
+ */
+void TST_VContour::SimplifyKeepsShape() const
+{
+    VContour contour(2000, 1000);
+    contour.SetShift(7);
+
+    qsrand(1);
+    QVector<QPointF> corners;
+    const int count = 30;
+    for (int i = 0; i < count; ++i)
+    {
+        const qreal angle = 2*M_PI*i/count;
+        const qreal radius = 100 + qrand() % 300;
+        corners.append(QPointF(500 + radius*qCos(angle), 500 + radius*qSin(angle)));
+    }
+
+    QVector<QPointF> points;
+    for (int i = 0; i < corners.size(); ++i)
+    {
+        const QVector<QPointF> cut = contour.CutEdge(QLineF(corners.at(i), corners.at((i + 1) % corners.size())));
+        for (int j = 0; j < cut.size()-1; ++j)
+        {
+            points.append(cut.at(j));
+        }
+    }
+
+    const QVector<QPointF> simplified = VContour::Simplify(points);
+    QVERIFY(simplified.size() <= corners.size());
+
+    for (int i = 0; i < points.size(); ++i)
+    {
+        QVERIFY2(DistanceToContour(points.at(i), simplified) <= 0.001,
+                 qPrintable(QString("Point %1 is too far from simplified contour.").arg(i)));
+    }
+
+    for (int i = 0; i < corners.size(); ++i)
+    {
+        QVERIFY2(DistanceToContour(corners.at(i), simplified) <= 0.001,
+                 qPrintable(QString("Corner %1 was cut off.").arg(i)));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContour::ExactContour() const
+{
+    const QVector<QPointF> points = QVector<QPointF>() << QPointF(0, 0) << QPointF(5, 0) << QPointF(10, 0)
+                                                       << QPointF(10, 10) << QPointF(0, 10);
+    VContour contour(100, 100);
+    contour.SetContour(points);
+
+    QCOMPARE(contour.GetExactContour(), points);
+    QCOMPARE(contour.GetContour().size(), 4);
+}
@@ -0,0 +1,169 @@
+/************************************************************************
+ **
+ **  @file   tst_vdependencygraph.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vdependencygraph.h"
+#include "../../app/xml/vdependencygraph.h"
+#include "../../app/xml/vpattern.h"
+#include "../../app/container/vcontainer.h"
+#include "../../app/tools/vabstracttool.h"
+
+#include <QtTest>
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VDependencyGraph::TST_VDependencyGraph(QObject *parent)
+    :QObject(parent), doc(QDomDocument()), pointA(QDomElement()), pointB(QDomElement()), line(QDomElement())
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief init pattern piece with point A, point B at end of line from A and line A-B.
+ */
+void TST_VDependencyGraph::init()
+{
+    doc = QDomDocument();
+    QDomElement calculation = doc.createElement("calculation");
+    doc.appendChild(calculation);
+
+    pointA = doc.createElement(VPattern::TagPoint);
+    pointA.setAttribute(VDomDocument::AttrId, 1);
+    pointA.setAttribute(VAbstractTool::AttrType, "single");
+    pointA.setAttribute(VAbstractTool::AttrName, "A");
+    pointA.setAttribute("x", 0);
+    pointA.setAttribute("y", 0);
+    calculation.appendChild(pointA);
+
+    pointB = doc.createElement(VPattern::TagPoint);
+    pointB.setAttribute(VDomDocument::AttrId, 2);
+    pointB.setAttribute(VAbstractTool::AttrType, "endLine");
+    pointB.setAttribute(VAbstractTool::AttrName, "B");
+    pointB.setAttribute(VAbstractTool::AttrBasePoint, 1);
+    pointB.setAttribute(VAbstractTool::AttrLength, "10");
+    pointB.setAttribute(VAbstractTool::AttrAngle, "0");
+    pointB.setAttribute(VAbstractTool::AttrMx, 0);
+    calculation.appendChild(pointB);
+
+    line = doc.createElement(VPattern::TagLine);
+    line.setAttribute(VDomDocument::AttrId, 3);
+    line.setAttribute(VAbstractTool::AttrFirstPoint, 1);
+    line.setAttribute(VAbstractTool::AttrSecondPoint, 2);
+    calculation.appendChild(line);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDependencyGraph::Collect(VDependencyGraph &graph, const VContainer &data) const
+{
+    graph.Begin();
+    graph.Append(pointA, Draw::Calculation, "PP");
+    graph.Append(pointB, Draw::Calculation, "PP");
+    graph.Append(line, Draw::Calculation, "PP");
+    graph.Finish(&data);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDependencyGraph::Unchanged() const
+{
+    const VContainer data;
+    VDependencyGraph graph;
+    Collect(graph, data);
+
+    QVERIFY(graph.IsValid());
+    QCOMPARE(graph.Count(), 3);
+    for (int i = 0; i < graph.Count(); ++i)
+    {
+        QVERIFY(graph.IsDirty(i, QSet<quint32>(), QSet<QString>()) == false);
+        QVERIFY(graph.IsRenamed(i) == false);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RenamePoint recalculation of renamed point would leave old name and variables Line_A_B, AngleLine_A_B in
+ * container, so the change must go to lite parse.
+ */
+void TST_VDependencyGraph::RenamePoint() const
+{
+    const VContainer data;
+    VDependencyGraph graph;
+    Collect(graph, data);
+
+    QDomElement renamed = pointB;
+    renamed.setAttribute(VAbstractTool::AttrName, "C");
+
+    QVERIFY(graph.IsDirty(1, QSet<quint32>(), QSet<QString>()));
+    QVERIFY(graph.IsRenamed(1));
+    QVERIFY(graph.IsRenamed(0) == false);
+    QVERIFY(graph.IsRenamed(2) == false);
+
+    graph.Update(1, &data);
+    QVERIFY(graph.IsRenamed(1) == false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDependencyGraph::RewireLine() const
+{
+    const VContainer data;
+    VDependencyGraph graph;
+    Collect(graph, data);
+
+    QDomElement rewired = line;
+    rewired.setAttribute(VAbstractTool::AttrFirstPoint, 2);
+    rewired.setAttribute(VAbstractTool::AttrSecondPoint, 1);
+
+    QVERIFY(graph.IsDirty(2, QSet<quint32>(), QSet<QString>()));
+    QVERIFY(graph.IsRenamed(2));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDependencyGraph::ChangeFormula() const
+{
+    const VContainer data;
+    VDependencyGraph graph;
+    Collect(graph, data);
+
+    QDomElement changed = pointB;
+    changed.setAttribute(VAbstractTool::AttrLength, "20");
+
+    QVERIFY(graph.IsDirty(1, QSet<quint32>(), QSet<QString>()));
+    QVERIFY(graph.IsRenamed(1) == false);
+
+    // Line uses point B, so it is recalculated after it.
+    QVERIFY(graph.IsDirty(2, QSet<quint32>() << 2, QSet<QString>()));
+    QVERIFY(graph.IsRenamed(2) == false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDependencyGraph::MoveLabel() const
+{
+    const VContainer data;
+    VDependencyGraph graph;
+    Collect(graph, data);
+
+    QDomElement moved = pointB;
+    moved.setAttribute(VAbstractTool::AttrMx, 5);
+
+    QVERIFY(graph.IsDirty(1, QSet<quint32>(), QSet<QString>()));
+    QVERIFY(graph.IsRenamed(1) == false);
+}
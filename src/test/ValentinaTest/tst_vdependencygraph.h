@@ -0,0 +1,59 @@
+/************************************************************************
+ **
+ **  @file   tst_vdependencygraph.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef TST_VDEPENDENCYGRAPH_H
+#define TST_VDEPENDENCYGRAPH_H
+
+#include <QObject>
+#include <QDomDocument>
+
+class VDependencyGraph;
+class VContainer;
+
+class TST_VDependencyGraph : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TST_VDependencyGraph(QObject *parent = nullptr);
+
+private slots:
+    void init();
+    void Unchanged() const;
+    void RenamePoint() const;
+    void RewireLine() const;
+    void ChangeFormula() const;
+    void MoveLabel() const;
+
+private:
+    QDomDocument doc;
+    QDomElement  pointA;
+    QDomElement  pointB;
+    QDomElement  line;
+
+    void Collect(VDependencyGraph &graph, const VContainer &data) const;
+};
+
+#endif // TST_VDEPENDENCYGRAPH_H
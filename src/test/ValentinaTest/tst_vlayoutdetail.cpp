@@ -0,0 +1,191 @@
+/************************************************************************
+ **
+ **  @file   tst_vlayoutdetail.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vlayoutdetail.h"
+#include "../../libs/vlayout/vlayoutdetail.h"
+
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+qreal Cross(const QPointF &o, const QPointF &a, const QPointF &b)
+{
+    return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool SamePoint(const QPointF &p1, const QPointF &p2)
+{
+    return QLineF(p1, p2).length() < 1e-9;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VLayoutDetail::TST_VLayoutDetail(QObject *parent)
+    :QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutDetail::ConvexHull_data() const
+{
+    QTest::addColumn<QVector<QPointF>>("points");
+    QTest::addColumn<QVector<QPointF>>("expectedHull");
+
+    const QVector<QPointF> square = QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10)
+                                                       << QPointF(0, 10);
+
+    QTest::newRow("Square") << square << square;
+
+    QTest::newRow("Square with inner points")
+            << (QVector<QPointF>() << QPointF(5, 5) << QPointF(0, 10) << QPointF(2, 8) << QPointF(10, 0)
+                                   << QPointF(0, 0) << QPointF(10, 10) << QPointF(7, 3))
+            << square;
+
+    QTest::newRow("Points on edges")
+            << (QVector<QPointF>() << QPointF(0, 0) << QPointF(5, 0) << QPointF(10, 0) << QPointF(10, 5)
+                                   << QPointF(10, 10) << QPointF(5, 10) << QPointF(0, 10) << QPointF(0, 5))
+            << square;
+
+    QTest::newRow("Duplicate points")
+            << (QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 0) << QPointF(10, 10)
+                                   << QPointF(0, 10) << QPointF(0, 0))
+            << square;
+
+    QTest::newRow("Concave contour")
+            << (QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10) << QPointF(5, 2)
+                                   << QPointF(0, 10))
+            << square;
+
+    const QVector<QPointF> twoPoints = QVector<QPointF>() << QPointF(0, 0) << QPointF(10, 10);
+    QTest::newRow("Less than three points") << twoPoints << twoPoints;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutDetail::ConvexHull() const
+{
+    QFETCH(QVector<QPointF>, points);
+    QFETCH(QVector<QPointF>, expectedHull);
+
+    QCOMPARE(VLayoutDetail::ConvexHull(points), expectedHull);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ConvexHullRandom hull must be convex, contain all points and consist of them.
+ */
+void TST_VLayoutDetail::ConvexHullRandom() const
+{
+    qsrand(1);
+    for (int test = 0; test < 50; ++test)
+    {
+        QVector<QPointF> points;
+        const int count = 10 + qrand() % 200;
+        for (int i = 0; i < count; ++i)
+        {
+            points.append(QPointF(qrand() % 1000, qrand() % 1000));
+        }
+
+        const QVector<QPointF> hull = VLayoutDetail::ConvexHull(points);
+        QVERIFY(hull.size() >= 3);
+
+        for (int i = 0; i < hull.size(); ++i)
+        {
+            const QPointF &a = hull.at(i);
+            const QPointF &b = hull.at((i + 1) % hull.size());
+            const QPointF &c = hull.at((i + 2) % hull.size());
+
+            QVERIFY2(points.contains(a), "Hull point is not a point of the set.");
+            QVERIFY2(Cross(a, b, c) > 0, "Hull is not strictly convex or not counterclockwise.");
+
+            for (int j = 0; j < points.size(); ++j)
+            {
+                QVERIFY2(Cross(a, b, points.at(j)) >= 0, "Point lies outside of hull.");
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TransformedEdges cached edges, bounding rectangle and hull must follow every change of matrix.
+ */
+void TST_VLayoutDetail::TransformedEdges() const
+{
+    VLayoutDetail detail;
+    detail.SetCountourPoints(QVector<QPointF>() << QPointF(0, 0) << QPointF(100, 0) << QPointF(100, 50)
+                                                << QPointF(60, 80) << QPointF(0, 50));
+    detail.setSeamAllowance(false);
+    detail.SetLayoutWidth(10);
+    detail.SetLayoutAllowencePoints();
+    QVERIFY(detail.EdgesCount() >= 5);
+
+    QVector<QLineF> edges;
+    for (int i = 1; i <= detail.EdgesCount(); ++i)
+    {
+        edges.append(detail.Edge(i));
+    }
+    const QVector<QPointF> hull = detail.GetConvexHull();
+
+    detail.Rotate(QPointF(50, 50), 90);
+    detail.Translate(10, 20);
+
+    // The same transformations as VLayoutDetail::Rotate() and VLayoutDetail::Translate() do.
+    QTransform matrix;
+    matrix.translate(50, 50);
+    matrix.rotate(-90);
+    matrix.translate(-50, -50);
+    QTransform translation;
+    translation.translate(10, 20);
+    matrix *= translation;
+
+    QPointF topLeft = detail.Edge(1).p1();
+    QPointF bottomRight = topLeft;
+    for (int i = 1; i <= detail.EdgesCount(); ++i)
+    {
+        const QLineF edge = detail.Edge(i);
+        QVERIFY2(SamePoint(edge.p1(), matrix.map(edges.at(i-1).p1())), qPrintable(QString("Wrong edge %1.").arg(i)));
+        QVERIFY2(SamePoint(edge.p2(), matrix.map(edges.at(i-1).p2())), qPrintable(QString("Wrong edge %1.").arg(i)));
+        topLeft = QPointF(qMin(topLeft.x(), edge.x1()), qMin(topLeft.y(), edge.y1()));
+        bottomRight = QPointF(qMax(bottomRight.x(), edge.x1()), qMax(bottomRight.y(), edge.y1()));
+    }
+
+    QVERIFY(SamePoint(detail.BoundingRect().topLeft(), topLeft));
+    QVERIFY(SamePoint(detail.BoundingRect().bottomRight(), bottomRight));
+
+    const QVector<QPointF> transformedHull = detail.GetConvexHull();
+    QCOMPARE(transformedHull.size(), hull.size());
+    for (int i = 0; i < hull.size(); ++i)
+    {
+        QVERIFY(SamePoint(transformedHull.at(i), matrix.map(hull.at(i))));
+    }
+
+    detail.SetMatrix(QTransform());
+    for (int i = 1; i <= detail.EdgesCount(); ++i)
+    {
+        QVERIFY(SamePoint(detail.Edge(i).p1(), edges.at(i-1).p1()));
+    }
+}
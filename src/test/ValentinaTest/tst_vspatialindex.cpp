@@ -0,0 +1,221 @@
+/************************************************************************
+ **
+ **  @file   tst_vspatialindex.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vspatialindex.h"
+#include "../../libs/vlayout/vspatialindex.h"
+#include "../../libs/vlayout/vcontour.h"
+
+#include <QtTest>
+#include <QtCore/qmath.h>
+#include <algorithm>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+bool BoundingRectsTouch(const QLineF &edge, const QRectF &rect)
+{
+    return qMax(edge.x1(), edge.x2()) >= rect.left() && qMin(edge.x1(), edge.x2()) <= rect.right() &&
+           qMax(edge.y1(), edge.y2()) >= rect.top() && qMin(edge.y1(), edge.y2()) <= rect.bottom();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QPointF RandomPoint()
+{
+    return QPointF(qrand() % 1000, qrand() % 1000);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RayCast classical even-odd ray casting through all edges. Slab decomposition must give the same answer.
+ */
+bool RayCast(const QVector<QPointF> &polygon, const QPointF &p)
+{
+    const int polyCorners = polygon.size();
+    int j = polyCorners-1;
+    bool oddNodes = false;
+
+    for (int i = 0; i < polyCorners; i++)
+    {
+        const qreal xi = polygon.at(i).x();
+        const qreal xj = polygon.at(j).x();
+        const qreal yi = polygon.at(i).y();
+        const qreal yj = polygon.at(j).y();
+
+        if ((yi < p.y() && yj >= p.y()) || (yj < p.y() && yi >= p.y()))
+        {
+            const qreal constant = xi - (yi*xj)/(yj-yi) + (yi*xi)/(yj-yi);
+            const qreal multiple = (xj-xi)/(yj-yi);
+            oddNodes ^= (p.y() * multiple + constant < p.x());
+        }
+
+        j = i;
+    }
+    return oddNodes;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> StarPolygon(int count)
+{
+    QVector<QPointF> polygon;
+    for (int i = 0; i < count; ++i)
+    {
+        const qreal angle = 2*M_PI*i/count;
+        const qreal radius = 100 + qrand() % 400;
+        polygon.append(QPointF(500 + qRound(radius*qCos(angle)), 500 + qRound(radius*qSin(angle))));
+    }
+    return polygon;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VSpatialIndex::TST_VSpatialIndex(QObject *parent)
+    :QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates index must return every edge which bounding rectangle touches the query, sorted and without
+ * duplicates. Edges that only share a cell may be returned too.
+ */
+void TST_VSpatialIndex::Candidates() const
+{
+    qsrand(1);
+    QVector<QLineF> lines;
+    for (int i = 0; i < 500; ++i)
+    {
+        const QPointF p = RandomPoint();
+        lines.append(QLineF(p, p + QPointF(qrand() % 100 - 50, qrand() % 100 - 50)));
+    }
+    lines.append(QLineF(0, 500, 1000, 500));// Long horizontal edge crosses many cells
+
+    VSpatialIndex index;
+    index.Build(lines);
+    QCOMPARE(index.EdgesCount(), lines.size());
+
+    for (int q = 0; q < 200; ++q)
+    {
+        const QRectF rect = QRectF(RandomPoint(), QSizeF(qrand() % 200, qrand() % 200));
+
+        QVector<int> result;
+        index.Candidates(rect, result);
+
+        for (int k = 1; k < result.size(); ++k)
+        {
+            QVERIFY2(result.at(k-1) < result.at(k), "Result must be sorted and without duplicates.");
+        }
+
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            if (BoundingRectsTouch(lines.at(i), rect))
+            {
+                QVERIFY2(std::binary_search(result.constBegin(), result.constEnd(), i+1),
+                         qPrintable(QString("Edge %1 is missed.").arg(i+1)));
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EdgesOfContour index of global contour keeps the same numeration of edges as VContour::GlobalEdge().
+ */
+void TST_VSpatialIndex::EdgesOfContour() const
+{
+    VContour contour(1000, 1000);
+    contour.SetContour(QVector<QPointF>() << QPointF(0, 0) << QPointF(300, 0) << QPointF(300, 200)
+                                          << QPointF(100, 250) << QPointF(0, 200));
+    const VSpatialIndex index(contour);
+
+    QCOMPARE(index.EdgesCount(), contour.EdgesCount());
+    for (int i = 1; i <= contour.EdgesCount(); ++i)
+    {
+        QCOMPARE(index.Edge(i), contour.GlobalEdge(i));
+    }
+    QVERIFY(index.HasNullEdge() == false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpatialIndex::InsidePolygon_data() const
+{
+    QTest::addColumn<QVector<QPointF>>("polygon");
+
+    QTest::newRow("Square") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(100, 0) << QPointF(100, 100)
+                                                   << QPointF(0, 100));
+
+    QVector<QPointF> comb;
+    comb << QPointF(0, 0) << QPointF(100, 0);
+    for (int x = 100; x > 0; x -= 20)
+    {
+        comb << QPointF(x, 100) << QPointF(x-10, 100) << QPointF(x-10, 20) << QPointF(x-20, 20);
+    }
+    QTest::newRow("Comb") << comb;
+
+    QTest::newRow("Same y of points") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(50, 50) << QPointF(100, 0)
+                                                             << QPointF(100, 100) << QPointF(50, 50)
+                                                             << QPointF(0, 100));
+
+    QTest::newRow("Self-crossing") << (QVector<QPointF>() << QPointF(0, 0) << QPointF(100, 100) << QPointF(100, 0)
+                                                          << QPointF(0, 100));
+
+    qsrand(1);
+    QTest::newRow("Star 50") << StarPolygon(50);
+    QTest::newRow("Star 1000") << StarPolygon(1000);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpatialIndex::InsidePolygon() const
+{
+    QFETCH(QVector<QPointF>, polygon);
+
+    VContour contour;
+    contour.SetContour(polygon);
+    const VSpatialIndex index(contour);
+
+    const QRectF rect = QPolygonF(polygon).boundingRect().adjusted(-10, -10, 10, 10);
+    // Shift of grid keeps points away from vertices. Order of edges that touch there is not defined.
+    const qreal step = qMax(rect.width(), rect.height())/200;
+    for (qreal y = rect.top() + step/3; y <= rect.bottom(); y += step)
+    {
+        for (qreal x = rect.left() + step/7; x <= rect.right(); x += step)
+        {
+            const QPointF p(x, y);
+            QVERIFY2(index.InsidePolygon(p) == RayCast(polygon, p),
+                     qPrintable(QString("Wrong result for point (%1; %2).").arg(x).arg(y)));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpatialIndex::InsideArbitraryEdges() const
+{
+    const QVector<QLineF> lines = QVector<QLineF>() << QLineF(0, 0, 100, 0) << QLineF(100, 0, 100, 100)
+                                                    << QLineF(100, 100, 0, 100) << QLineF(0, 100, 0, 0);
+    VSpatialIndex index;
+    index.Build(lines);
+
+    QCOMPARE(index.EdgesCount(), lines.size());
+    QVERIFY2(index.InsidePolygon(QPointF(50, 50)) == false, "Index of arbitrary edges doesn't have a polygon.");
+}
@@ -0,0 +1,46 @@
+/************************************************************************
+ **
+ **  @file   tst_vspatialindex.h
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef TST_VSPATIALINDEX_H
+#define TST_VSPATIALINDEX_H
+
+#include <QObject>
+
+class TST_VSpatialIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TST_VSpatialIndex(QObject *parent = nullptr);
+
+private slots:
+    void Candidates() const;
+    void EdgesOfContour() const;
+    void InsidePolygon_data() const;
+    void InsidePolygon() const;
+    void InsideArbitraryEdges() const;
+};
+
+#endif // TST_VSPATIALINDEX_H
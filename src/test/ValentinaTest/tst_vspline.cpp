@@ -0,0 +1,229 @@
+/************************************************************************
+ **
+ **  @file   tst_vspline.cpp
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2015 Valentina project
+ **  <https://bitbucket.org/dismine/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vspline.h"
+#include "../../app/geometry/vspline.h"
+#include "../../app/core/vapplication.h"
+
+#include <QtTest>
+
+Q_DECLARE_METATYPE(VSpline)
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+QPointF PointAt(const VSpline &spl, qreal t)
+{
+    const QPointF p1 = spl.GetP1().toQPointF();
+    const QPointF p2 = spl.GetP2();
+    const QPointF p3 = spl.GetP3();
+    const QPointF p4 = spl.GetP4().toQPointF();
+    const qreal mt = 1 - t;
+    return mt*mt*mt*p1 + 3*mt*mt*t*p2 + 3*mt*t*t*p3 + t*t*t*p4;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal DistanceToPolyline(const QPointF &p, const QVector<QPointF> &points)
+{
+    qreal distance = -1;
+    for (int i = 0; i < points.size()-1; ++i)
+    {
+        const QLineF segment(points.at(i), points.at(i+1));
+        const qreal length2 = segment.dx()*segment.dx() + segment.dy()*segment.dy();
+        qreal t = 0;
+        if (length2 > 0)
+        {
+            t = qBound(0.0, ((p.x() - segment.x1())*segment.dx() + (p.y() - segment.y1())*segment.dy())/length2, 1.0);
+        }
+        const qreal d = QLineF(p, segment.pointAt(t)).length();
+        if (distance < 0 || d < distance)
+        {
+            distance = d;
+        }
+    }
+    return distance;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PolylineLength length of curve from 0 to t measured by very fine polyline.
+ */
+qreal PolylineLength(const VSpline &spl, qreal t)
+{
+    const int steps = 20000;
+    qreal length = 0;
+    QPointF previous = PointAt(spl, 0);
+    for (int i = 1; i <= steps; ++i)
+    {
+        const QPointF current = PointAt(spl, t*i/steps);
+        length += QLineF(previous, current).length();
+        previous = current;
+    }
+    return length;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void AddSplines()
+{
+    QTest::addColumn<VSpline>("spl");
+
+    QTest::newRow("Simple") << VSpline(VPointF(QPointF(0, 0)), QPointF(100, 200), QPointF(300, 200),
+                                       VPointF(QPointF(400, 0)), 1);
+    QTest::newRow("S curve") << VSpline(VPointF(QPointF(0, 0)), QPointF(400, 0), QPointF(0, 400),
+                                        VPointF(QPointF(400, 400)), 1);
+    QTest::newRow("Loop") << VSpline(VPointF(QPointF(0, 0)), QPointF(500, 300), QPointF(-100, 300),
+                                     VPointF(QPointF(400, 0)), 1);
+    QTest::newRow("Crossed handles") << VSpline(VPointF(QPointF(0, 0)), QPointF(300, 200), QPointF(100, 200),
+                                                VPointF(QPointF(400, 0)), 1);
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VSpline::TST_VSpline(QObject *parent)
+    :QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::initTestCase()
+{
+    // Tolerance of flattening is given in pattern units.
+    qApp->setPatternUnit(Unit::Cm);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::Flatten_data() const
+{
+    AddSplines();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Flatten spline must not deviate from its polyline more than tolerance. Bigger tolerance gives less points.
+ */
+void TST_VSpline::Flatten() const
+{
+    QFETCH(VSpline, spl);
+
+    int previousCount = 0;
+    const QVector<qreal> tolerances = QVector<qreal>() << 0.005 << 0.05 << 0.5;
+    for (int k = 0; k < tolerances.size(); ++k)
+    {
+        const QVector<QPointF> points = spl.FlattenPoints(tolerances.at(k));
+        QVERIFY(points.size() >= 2);
+        QCOMPARE(points.first(), spl.GetP1().toQPointF());
+        QCOMPARE(points.last(), spl.GetP4().toQPointF());
+
+        const qreal tolerance = qApp->toPixel(tolerances.at(k));
+        const int steps = 2000;
+        for (int i = 0; i <= steps; ++i)
+        {
+            const qreal distance = DistanceToPolyline(PointAt(spl, static_cast<qreal>(i)/steps), points);
+            QVERIFY2(distance <= tolerance*1.01,
+                     qPrintable(QString("Distance %1 is bigger than tolerance %2.").arg(distance).arg(tolerance)));
+        }
+
+        if (k > 0)
+        {
+            QVERIFY(points.size() <= previousCount);
+        }
+        previousCount = points.size();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::StraightLength() const
+{
+    const VSpline spl(VPointF(QPointF(0, 0)), QPointF(100, 0), QPointF(200, 0), VPointF(QPointF(300, 0)), 1);
+
+    QVERIFY(qAbs(spl.GetLength() - 300) < 0.0001);
+    QVERIFY(qAbs(spl.LengthT(0.5) - 150) < 0.0001);
+    QVERIFY(qAbs(spl.ParamByLength(150) - 0.5) < 0.0001);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::ArcLength_data() const
+{
+    AddSplines();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::ArcLength() const
+{
+    QFETCH(VSpline, spl);
+
+    const qreal length = PolylineLength(spl, 1);
+    QVERIFY2(qAbs(spl.GetLength() - length) < 0.001,
+             qPrintable(QString("Length %1, expected %2.").arg(spl.GetLength()).arg(length)));
+
+    qreal previous = 0;
+    for (int i = 1; i <= 10; ++i)
+    {
+        const qreal t = i/10.0;
+        const qreal lengthT = spl.LengthT(t);
+        QVERIFY2(qAbs(lengthT - PolylineLength(spl, t)) < 0.001, qPrintable(QString("Wrong length for t=%1.").arg(t)));
+        QVERIFY(lengthT >= previous);
+        previous = lengthT;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::ParamByLength_data() const
+{
+    AddSplines();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::ParamByLength() const
+{
+    QFETCH(VSpline, spl);
+
+    const qreal fullLength = spl.GetLength();
+    QCOMPARE(spl.ParamByLength(0), 0.0);
+
+    for (int i = 1; i <= 20; ++i)
+    {
+        const qreal length = fullLength*i/20;
+        const qreal t = spl.ParamByLength(length);
+        QVERIFY(t >= 0 && t <= 1);
+        QVERIFY2(qAbs(spl.LengthT(t) - length) < 0.001,
+                 qPrintable(QString("Length at t=%1 is %2, expected %3.").arg(t).arg(spl.LengthT(t)).arg(length)));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::CutSpline() const
+{
+    const VSpline spl(VPointF(QPointF(0, 0)), QPointF(100, 200), QPointF(300, 200), VPointF(QPointF(400, 0)), 1);
+    const qreal length = spl.GetLength()/3;
+
+    VSpline spl1;
+    VSpline spl2;
+    const QPointF cutPoint = spl.CutSpline(length, spl1, spl2);
+
+    QVERIFY(QLineF(cutPoint, PointAt(spl, spl.ParamByLength(length))).length() < 0.001);
+    QVERIFY(qAbs(spl1.GetLength() - length) < 0.001);
+    QVERIFY(qAbs(spl1.GetLength() + spl2.GetLength() - spl.GetLength()) < 0.001);
+}
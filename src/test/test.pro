@@ -1,3 +1,6 @@
 TEMPLATE = subdirs
 CONFIG   += ordered
-SUBDIRS = ParserTest
+SUBDIRS = \
+    ParserTest \
+    LayoutBenchmark \
+    ValentinaTest